@@ -0,0 +1,152 @@
+//! \brief Benchmark of the input graph formats ingest by the High Resolution Hierarchical Clustering with Stable State (HiReCS) client
+//! 	The same random graph is written in each input format, then loaded
+//! 	by the client and converted into .higb. The .higb writing takes the
+//! 	same time for all formats, so the difference is the ingest time.
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <cstdio>
+#include <cstdlib>  // strtoul
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/stat.h>  // stat
+#include "client.h"
+
+using std::string;
+using std::vector;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+
+//! Undirected weighted link of the generated graph
+struct Edge {
+	Id  src;  //!< Source node id, < dst
+	Id  dst;  //!< Dest node id
+	unsigned  weight;  //!< Link weight
+};
+
+//! \brief Write the edges in the specified format
+//!
+//! \param filename const string&  - output file name
+//! \param fmt InputFormat  - format of the file
+//! \param nodesNum Id  - number of nodes, ids are [1, nodesNum]
+//! \param edges const vector<Edge>&  - edges ordered by src
+//! \return void
+void writeGraph(const string& filename, InputFormat fmt, Id nodesNum, const vector<Edge>& edges)
+{
+	FILE*  fout = fopen(filename.c_str(), "w");
+	if(!fout) {
+		perror(filename.c_str());
+		exit(1);
+	}
+	switch(fmt) {
+	case InputFormat::HIG:
+		fprintf(fout, "/Graph weighted:1\n/Nodes %u 1\n/Edges\n", nodesNum);
+		for(size_t i = 0; i < edges.size(); ++i) {
+			if(!i || edges[i].src != edges[i - 1].src)
+				fprintf(fout, i ? "\n%u>" : "%u>", edges[i].src);
+			fprintf(fout, " %u:%u", edges[i].dst, edges[i].weight);
+		}
+		fputc('\n', fout);
+		break;
+	case InputFormat::PAJEK:
+		fprintf(fout, "*Vertices %u\n*Edges\n", nodesNum);
+		for(const auto& eg: edges)
+			fprintf(fout, "%u %u %u\n", eg.src, eg.dst, eg.weight);
+		break;
+	case InputFormat::EDGELIST:
+		for(const auto& eg: edges)
+			fprintf(fout, "%u\t%u\t%u\n", eg.src, eg.dst, eg.weight);
+		break;
+	case InputFormat::MTX:
+		fprintf(fout, "%%%%MatrixMarket matrix coordinate integer symmetric\n%u %u %lu\n"
+			, nodesNum, nodesNum, (unsigned long)edges.size());
+		for(const auto& eg: edges)
+			fprintf(fout, "%u %u %u\n", eg.dst, eg.src, eg.weight);
+		break;
+	default:
+		fprintf(stderr, "writeGraph(), unexpected format\n");
+		exit(1);
+	}
+	fclose(fout);
+}
+
+//! \brief Convert the input graph into .higb by the client
+//!
+//! \param inpfile const string&  - input graph
+//! \param higbfile const string&  - resulting .higb file
+//! \return double  - elapsed seconds
+double convert(const string& inpfile, const string& higbfile)
+{
+	string  optb = "-b" + higbfile;
+	string  inp = inpfile;
+	char  name[] = "readers";
+	// Note: weights of the edge list are loaded only on request, the other
+	// formats ignore it
+	char  opte[] = "-e";
+	char*  argv[] = {name, opte, &optb[0], &inp[0]};
+	const auto  tstart = steady_clock::now();
+	Client  client;
+	if(!client.parseArgs(4, argv))
+		exit(1);
+	client.process();
+	return duration<double>(steady_clock::now() - tstart).count();
+}
+
+int main(int argc, char* argv[])
+{
+	const Id  nodesNum = argc >= 2 ? strtoul(argv[1], nullptr, 10) : 200000;
+	const Id  degree = argc >= 3 ? strtoul(argv[2], nullptr, 10) : 10;
+	if(!nodesNum || nodesNum < degree) {
+		printf("Usage: %s [<nodes>=200000] [<degree>=10]\n", argv[0]);
+		return 1;
+	}
+
+	// Random undirected graph with ~degree links per node
+	std::mt19937  rnd(nodesNum);
+	std::uniform_int_distribution<Id>  rdest(1, nodesNum);
+	std::uniform_int_distribution<unsigned>  rweight(1, 9);
+	vector<Edge>  edges;
+	edges.reserve(size_t(nodesNum) * degree / 2);
+	for(Id src = 1; src <= nodesNum; ++src)
+		for(Id j = 0; j < degree / 2; ++j) {
+			const Id  dst = rdest(rnd);
+			if(dst > src)
+				edges.push_back(Edge{src, dst, rweight(rnd)});
+		}
+	printf("nodes: %u, edges: %lu\n", nodesNum, (unsigned long)edges.size());
+
+	const string  higbfile = "bench_readers.higb";
+	const struct {
+		const char*  ext;
+		InputFormat  fmt;
+	} formats[] = {{"hig", InputFormat::HIG}, {"net", InputFormat::PAJEK}
+		, {"el", InputFormat::EDGELIST}, {"mtx", InputFormat::MTX}};
+	for(const auto& fmt: formats) {
+		const string  filename = string("bench_readers.") + fmt.ext;
+		writeGraph(filename, fmt.fmt, nodesNum, edges);
+		struct stat  st;
+		stat(filename.c_str(), &st);
+		const double  tconv = convert(filename, higbfile);
+		remove(filename.c_str());
+		printf("%s: %.1f MB, ingest + .higb: %.3f sec\n", fmt.ext, st.st_size / 1048576., tconv);
+	}
+	// Reference: the .higb loading without parsing
+	const auto  tstart = steady_clock::now();
+	{
+		MappedFile  infile(higbfile);
+		Graph<true>::NodesT  nodes;
+		loadHigb<true>(infile, nodes);
+	}
+	printf("higb: loading: %.3f sec\n", duration<double>(steady_clock::now() - tstart).count());
+	remove(higbfile.c_str());
+	return 0;
+}
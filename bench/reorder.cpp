@@ -0,0 +1,92 @@
+//! \brief Benchmark of the nodes reordering for the High Resolution Hierarchical Clustering with Stable State (HiReCS) library
+//! 	Shuffled grid graph is reordered by each nodes order, then the mean
+//! 	links span, the reordering time and the time of the nodes sweep by
+//! 	their links (as the clustering does) are reported.
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <cstdio>
+#include <cstdlib>  // strtoul
+#include <chrono>
+#include "hirecs.hpp"
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using namespace hirecs;
+
+
+//! \brief Seconds elapsed since the time point
+//!
+//! \param tstart steady_clock::time_point  - start time
+//! \return double  - elapsed seconds
+double elapsed(steady_clock::time_point tstart)
+{
+	return duration<double>(steady_clock::now() - tstart).count();
+}
+
+//! \brief Benchmark the nodes order
+//!
+//! \param side Id  - side of the square grid
+//! \param order NodesOrder  - order of the nodes
+//! \param threads unsigned  - number of threads
+//! \return void
+void benchOrder(Id side, NodesOrder order, unsigned threads)
+{
+	// Note: the shuffled nodes and links simulate the random input order
+	Graph<true>  graph(side * side, true, side);
+	graph.addNodes(0, side * side);
+	for(Id i = 0; i < side * side; ++i) {
+		Graph<true>::InpLinksT  links;
+		if(i % side + 1 < side)
+			links.emplace_back(i + 1, 1);
+		if(i + side < side * side)
+			links.emplace_back(i + side, 1);
+		graph.addNodeLinks<false>(i, links);
+	}
+	auto&  nodes = graph.finalize(threads);
+	const double  span = linksSpan(nodes, threads);
+
+	auto  tstart = steady_clock::now();
+	orderNodes(nodes, order, threads);
+	const double  torder = elapsed(tstart);
+
+	// Sweep nodes by the links as the clustering does
+	tstart = steady_clock::now();
+	AccWeight  wsum = 0;
+	for(unsigned i = 0; i < 16; ++i)
+		for(const auto& nd: nodes)
+			for(const auto& ln: nd.links)
+				wsum += ln.weight + ln.dest->selfWeight() + ln.dest->links.size();
+	const double  tsweep = elapsed(tstart);
+
+	printf("links span: %.1f -> %.1f, reordering: %.3f sec, 16 sweeps: %.3f sec (%.0f)\n"
+		, span, linksSpan(nodes, threads), torder, tsweep, wsum);
+}
+
+int main(int argc, char* argv[])
+{
+	const Id  side = argc >= 2 ? strtoul(argv[1], nullptr, 10) : 1000;
+	const unsigned  threads = argc >= 3 ? strtoul(argv[2], nullptr, 10) : 1;
+	if(side < 2) {
+		printf("Usage: %s [<grid_side>=1000] [<threads>=1]\n", argv[0]);
+		return 1;
+	}
+	printf("grid: %u x %u, threads: %u\n", side, side, threads);
+	const struct {
+		const char*  name;
+		NodesOrder  order;
+	} orders[] = {{"none", NodesOrder::NONE}, {"degree", NodesOrder::DEGREE}
+		, {"bfs", NodesOrder::BFS}, {"rcm", NodesOrder::RCM}};
+	for(const auto& ord: orders) {
+		printf("%s: ", ord.name);
+		fflush(stdout);
+		benchOrder(side, ord.order, threads);
+	}
+	return 0;
+}
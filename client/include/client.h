@@ -11,9 +11,15 @@
 #define CLIENT_H
 
 #include <string>
+#include <vector>
+#include <utility>  // pair
 #include "hirecs.hpp"
+#include "fileio.h"
+#include "readers.h"  // InputFormat
 
 using std::string;
+using std::vector;
+using std::pair;
 using namespace hirecs;
 
 
@@ -53,7 +59,7 @@ public:
 	void process();
 
     //! \brief Build hierarchy from nodes
-    //! 	Output results to stdout, stderr
+    //! 	Output results to stdout (or outfile), stderr
     //!
     //! \param nodes Nodes<LinksT>&  - nodes with links to be processed
     //! \param symmetric bool  - whether links are symmetric (undirected)
@@ -67,11 +73,18 @@ public:
     //! \param extoutp=0 bool  - extended output hierarchy format
     //!     1  - show inter-cluster links
     //!     2  - unwrap root clusters to nodes
+    //! \param threads=1 unsigned  - number of threads for the links validation
+    //! 	and reordering
+    //! \param outfile=string() const string&  - output file of the hierarchy,
+    //! 	stdout if empty
+    //! \param order=NodesOrder::NONE NodesOrder  - reordering of the nodes to
+    //! 	improve locality of the links before the clustering
     //! \return void
 	template<typename LinksT>
 	static void processNodes(Nodes<LinksT>& nodes, bool symmetric
 		, bool validate=true, bool fast=false, float modProfitMarg=-0.999
-		, char outfmt='t', uint8_t extoutp=0);
+		, char outfmt='t', uint8_t extoutp=0, unsigned threads=1
+		, const string& outfile=string(), NodesOrder order=NodesOrder::NONE);
 protected:
     //! .hig file sections, similar to Pajec format, but more compact and readable
 	enum class FileSection
@@ -83,18 +96,115 @@ protected:
 		ARCS  //  Directed links
 	};
 
+	//! \brief Links of the nodes parsed from a chunk of the links section
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	template<bool WEIGHTED=true>
+	struct LinksChunk {
+		using InpLinksT = typename Graph<WEIGHTED>::InpLinksT;  //!< \copydoc Graph<WEIGHTED>::InpLinksT
+
+		const char*  beg;  //!< Begin of the chunk in the input text
+		const char*  end;  //!< End of the chunk in the input text
+		//! Source nodes with the end offsets of their links in links
+		vector<pair<Id, size_t>>  nodes;
+		InpLinksT  links;  //!< Links of all nodes in the chunk
+
+		LinksChunk(): beg(nullptr), end(nullptr), nodes(), links()  {}
+	};
+
+	//! \brief Fetch the Graph creating it if required
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \return Graph<WEIGHTED>&  - the graph being constructed
+	template<bool WEIGHTED=true>
+	Graph<WEIGHTED>& graph();
+
+	//! \brief Parse links of the source node
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \param line const char*  - begin of the input line to be parsed, the source
+	//! 	node id can be preceded by spaces. Error positions are relative to it
+	//! \param lineEnd const char*  - end of the line (excluding)
+	//! \param nid Id&  - source node id
+	//! \param links InpLinksT&  - parsed links to be extended
+	//! \return bool  - whether the links specification is present in the line
+	template<bool WEIGHTED=true>
+	static bool scanLinks(const char* line, const char* lineEnd, Id& nid
+		, typename Graph<WEIGHTED>::InpLinksT& links);
+
+	//! \brief Store node links in the Graph
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \param nid Id  - source node id
+	//! \param links const InpLinksT&  - node links
+    //! \param directed bool  - directed (arcs) / undirected (edges) links
+	//! \return void
+	template<bool WEIGHTED=true>
+	void storeLinks(Id nid, const typename Graph<WEIGHTED>::InpLinksT& links
+		, bool directed);
+
 	//! \brief Extend the Graph by links parsing
 	//! \tparam WEIGHTED bool  - whether the link is weighted or not
-	//! \param line string&  - input string to be parsed for links creation
+	//! \param line const char*  - begin of the input line to be parsed for links
+	//! 	creation
+	//! \param lineEnd const char*  - end of the line (excluding)
     //! \param directed bool  - directed (arcs) / undirected (edges) links
+    //! \param links InpLinksT&  - links buffer of the caller, reused between
+    //! 	the lines to avoid reallocations
 	//! \return void
 	template<bool WEIGHTED=true>
-	void parseLinks(string& line, bool directed);
+	void parseLinks(const char* line, const char* lineEnd, bool directed
+		, typename Graph<WEIGHTED>::InpLinksT& links);
+
+	//! \brief Extend the Graph by the links section parsing in m_threads threads
+	//! 	The section is split into chunks by lines, which are parsed concurrently
+	//! 	and then merged into the Graph in the order of the input. On reserving,
+	//! 	the chunks are scanned concurrently to count links of the nodes, then
+	//! 	the lines are parsed directly into the Graph without the staging
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \param body const char*  - begin of the section body (after the header line)
+	//! \param end const char*  - end of the input text
+    //! \param directed bool  - directed (arcs) / undirected (edges) links
+    //! \param reserve=false bool  - count links of the nodes in the chunks and
+    //! 	reserve their exact capacity before the parsing, applicable for the
+    //! 	whole section and the specified nodes range
+	//! \return const char*  - end of the section (begin of the next header or end)
+	template<bool WEIGHTED=true>
+	const char* parseLinksSection(const char* body, const char* end, bool directed
+		, bool reserve=false);
+
+	//! \brief Extend the Graph by the .hig text parsing
+	//! \param data const char*  - begin of the text, starts from a line
+	//! \param end const char*  - end of the text, the last line is complete
+	//! \param sect FileSection&  - current section to be updated
+	//! \param weighted bool&  - whether the links are weighted, can be updated
+	//! \param whole=false bool  - the text contains whole sections, so links of
+	//! 	the nodes can be counted to be allocated once
+	//! \return void
+	void parseHig(const char* data, const char* end, FileSection& sect, bool& weighted
+		, bool whole=false);
+
+	//! \brief Parse section header of the input file
+	//! \param line string&  - header line starting from the section name
+	//! \param sect FileSection&  - current section to be updated
+	//! \param weighted bool&  - whether the links are weighted, can be updated
+	//! \return void
+	void parseSection(string& line, FileSection& sect, bool& weighted);
 
 	//! \brief Performs clustering of the graph into hierarchy
+	//! 	or saves it in the .higb format if m_higbfile is specified
 	//! \tparam WEIGHTED bool  - whether the link is weighted or not
 	template<bool WEIGHTED=true>
 	void processGraph();
+
+	//! \brief Load nodes from the .higb file and perform the clustering
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \param infile const MappedFile&  - mapped .higb file
+	template<bool WEIGHTED=true>
+	void processHigb(const MappedFile& infile);
+
+	//! \brief Load the graph from the file of the external format and process it
+	//! \tparam WEIGHTED bool  - whether the link is weighted or not
+	//! \param infile const MappedFile&  - mapped input file
+	//! \param fmt InputFormat  - format of the file: PAJEK, EDGELIST, METIS, MTX
+	template<bool WEIGHTED=true>
+	void processFormatted(const MappedFile& infile, InputFormat fmt);
 private:
 	// User defined parameters
 	char  m_outfmpt;  // Hierarchy output format
@@ -102,8 +212,17 @@ private:
 	bool  m_validate;  // Validate links (and fix) / skip validation
 	bool  m_fast;  // Perform strictly mutual / quazi-mutual (faster) clustering
 	bool  m_reorder;  // Shuffle (rand reorder) nodes and links
+	bool  m_resdub;  // Resolve duplicated links of the Pajek, edge list and mtx input
+	bool  m_arcs;  // Links of the edge list input are directed
+	bool  m_elweights;  // The third column of the edge list input is the link weight
+	unsigned  m_threads;  // Number of threads for the input parsing and links processing
+	RandSeed  m_seed;  // Seed of the shuffling
+	NodesOrder  m_order;  // Reordering of the nodes before the clustering
 	float  m_modProfitMarg;  // Profit margin for early terminaition of clustering
 	string  m_inpfile;
+	string  m_inpfmt;  // Input format, detected if empty
+	string  m_outfile;  // Output file of the hierarchy, stdout if empty
+	string  m_higbfile;  // Output .higb file to convert the input graph into
 	// File reader attributes
 	Id  m_nodesNum;
 	Id  m_nodesStartId;
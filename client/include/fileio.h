@@ -0,0 +1,304 @@
+//! \brief Files access for the High Resolution Hierarchical Clustering with Stable State (HiReCS) client
+//! 	Provides memory mapped files, streamed (stdin, gzip) text, in-place
+//! 	scanning of the textual values and buffered formatted output
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+#ifndef FILEIO_H
+#define FILEIO_H
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <cstdio>  // FILE
+#include <cstring>  // memcpy, strlen
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>  // exception_ptr
+#include <stdexcept>  // domain_error
+#include <zlib.h>  // gzFile
+#include "types.h"  // Id
+
+using std::string;
+using std::vector;
+using std::deque;
+using std::thread;
+using std::mutex;
+using std::condition_variable;
+using std::exception_ptr;
+using std::domain_error;
+using hirecs::Id;
+
+
+//! \brief Read-only memory mapped file
+//! \note Content of the file is not null-terminated
+class MappedFile {
+	const char*  m_data;  // Mapped content
+	size_t  m_size;  // Size of the mapped content
+public:
+	MappedFile(): m_data(nullptr), m_size(0)  {}
+
+    //! \brief Map the file for the reading
+    //!
+    //! \param filename const string&  - name of the file to be mapped
+	explicit MappedFile(const string& filename);
+
+	MappedFile(const MappedFile&)=delete;
+	MappedFile(MappedFile&& mf);
+
+	~MappedFile()  { close(); }
+
+	MappedFile& operator=(const MappedFile&)=delete;
+	MappedFile& operator=(MappedFile&& mf);
+
+    //! \brief Map the file for the reading closing the previously mapped one
+    //! \note system_error is thrown if the file can't be opened or mapped,
+    //! 	domain_error is thrown if the file is not a regular one
+    //!
+    //! \param filename const string&  - name of the file to be mapped
+    //! \return void
+	void open(const string& filename);
+
+    //! \brief Unmap the file if it was mapped
+    //!
+    //! \return void
+	void close();
+
+	const char* data() const  { return m_data; }  //!< Begin of the content
+	const char* end() const  { return m_data + m_size; }  //!< End of the content
+	size_t size() const  { return m_size; }  //!< Size of the content in bytes
+	bool empty() const  { return !m_size; }  //!< Whether the content is empty
+};
+
+//! \brief Whether the file is a regular one, so it can be mapped
+//! \note Pipes, sockets and devices do not provide their size and are streamed.
+//! 	system_error is thrown if the file attributes can't be fetched
+//!
+//! \param filename const string&  - name of the file
+//! \return bool  - the file is regular
+bool regularFile(const string& filename);
+
+//! \brief Whether the content is gzip compressed
+//!
+//! \param data const char*  - content
+//! \param size size_t  - size of the content
+//! \return bool  - the content starts with the gzip signature
+inline bool gzipMatches(const char* data, size_t size)
+{
+	return size >= 2 && data[0] == '\x1f' && data[1] == '\x8b';
+}
+
+//! \brief Text read by blocks of the whole lines from the stream (stdin or
+//! 	file) in the reader thread, gzip compressed content is decompressed
+//! 	transparently
+//! \note Reading and decompression are performed concurrently with the
+//! 	processing of the fetched blocks
+class TextStream {
+	gzFile  m_file;  // Input stream
+	deque<vector<char>>  m_ready;  // Blocks ready to be processed
+	vector<vector<char>>  m_free;  // Processed blocks to be reused
+	vector<char>  m_block;  // Block being processed
+	bool  m_eof;  // The stream is over (or failed)
+	bool  m_stop;  // Stop reading
+	exception_ptr  m_error;  // Reading error
+	mutex  m_mutex;  // Synchronization of the blocks queue
+	condition_variable  m_cond;  // Notification on the blocks queue update
+	thread  m_reader;  // Reader thread
+public:
+	//! Size of the read block in bytes
+	constexpr static size_t  BLOCK_SIZE = 4 << 20;
+	//! Max number of the read blocks waiting for the processing
+	constexpr static size_t  READY_MAX = 4;
+
+    //! \brief Open the stream and start reading
+    //! \note system_error is thrown if the file can't be opened
+    //!
+    //! \param filename const string&  - name of the file, "-" means stdin
+	explicit TextStream(const string& filename);
+
+	TextStream(const TextStream&)=delete;
+	TextStream& operator=(const TextStream&)=delete;
+
+    //! \brief Stop reading and close the stream
+	~TextStream();
+
+    //! \brief Fetch the next block of the text
+    //! \note The block remains valid until the next call
+    //!
+    //! \param data const char*&  - begin of the block
+    //! \param end const char*&  - end of the block, the last line of the block
+    //! 	is complete (ends with the new line) except the end of the stream
+    //! \return bool  - whether the block is fetched, false on the stream end
+	bool next(const char*& data, const char*& end);
+private:
+    //! \brief Read the stream by blocks, executed in the reader thread
+    //!
+    //! \return void
+	void read();
+};
+
+// In-place scanning of the text values ---------------------------------------
+//! \brief Whether the symbol is a values delimiter (space)
+//!
+//! \param c char  - symbol to be checked
+//! \return bool  - the symbol is a delimiter
+inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+//! \brief Skip spaces
+//!
+//! \param pos const char*  - current position
+//! \param end const char*  - end of the text
+//! \return const char*  - first non space position or end
+inline const char* skipSpaces(const char* pos, const char* end)
+{
+	while(pos != end && isSpace(*pos))
+		++pos;
+	return pos;
+}
+
+//! \brief Scan Id from the text
+//!
+//! \param pos const char*&  - position to start scanning, updated to the first
+//! 	symbol after the value
+//! \param end const char*  - end of the text
+//! \param id Id&  - resulting id
+//! \return bool  - whether the id is scanned, false if the value is invalid
+//! 	or out of range (pos is not updated in this case)
+inline bool scanId(const char*& pos, const char* end, Id& id)
+{
+	const char*  cur = pos;
+	uint64_t  val = 0;
+	while(cur != end && unsigned(*cur - '0') <= 9) {
+		val = val * 10 + (*cur++ - '0');
+		// Note: ID_NONE is reserved
+		if(val >= hirecs::ID_NONE)
+			return false;
+	}
+	if(cur == pos)
+		return false;
+	id = val;
+	pos = cur;
+	return true;
+}
+
+//! \brief Scan floating point value from the text
+//! 	Format: [+-]digits[.digits][{e,E}[+-]digits]
+//!
+//! \param pos const char*&  - position to start scanning, updated to the first
+//! 	symbol after the value
+//! \param end const char*  - end of the text
+//! \param val float&  - resulting value
+//! \return bool  - whether the value is scanned, false if it's invalid
+//! 	(pos is not updated in this case)
+bool scanFloat(const char*& pos, const char* end, float& val);
+
+//! \brief Form exception about the invalid value format in the line
+//!
+//! \param line const char*  - begin of the line
+//! \param lineEnd const char*  - end of the line
+//! \param pos const char*  - position of the invalid value
+//! \param ctxSize size_t  - number of the context symbols around the position
+//! \return domain_error  - formed exception
+domain_error invalidValueFormat(const char* line, const char* lineEnd
+	, const char* pos, size_t ctxSize);
+
+// Buffered formatted output -------------------------------------------------
+//! \brief Buffered writer of the formatted output
+//! 	Values are formatted in place into the reusable buffer, which is written
+//! 	to the file by blocks
+//! \note system_error is thrown on the output errors
+class OutWriter {
+	FILE*  m_file;  // Output file
+	bool  m_owner;  // Whether the file is opened (and closed) by the writer
+	vector<char>  m_buf;  // Output buffer
+	size_t  m_size;  // Size of the buffered content
+public:
+	//! Size of the output buffer in bytes
+	constexpr static size_t  BUFFER_SIZE = 1 << 20;
+
+    //! \brief Open the output
+    //!
+    //! \param filename=string() const string&  - name of the output file,
+    //! 	stdout if empty
+	explicit OutWriter(const string& filename=string());
+
+	OutWriter(const OutWriter&)=delete;
+	OutWriter& operator=(const OutWriter&)=delete;
+
+    //! \brief Flush the buffered content and close the output
+    //! \note Errors are omitted here, close() should be called to handle them
+	~OutWriter();
+
+    //! \brief Write the buffered content to the file
+    //!
+    //! \return void
+	void flush();
+
+    //! \brief Flush the buffered content and close the output file if owned
+    //!
+    //! \return void
+	void close();
+
+    //! \brief Write the symbol
+    //!
+    //! \param c char  - symbol
+    //! \return OutWriter&  - this writer
+	OutWriter& put(char c)
+	{
+		if(m_size == m_buf.size())
+			flush();
+		m_buf[m_size++] = c;
+		return *this;
+	}
+
+    //! \brief Write the text
+    //!
+    //! \param text const char*  - text
+    //! \param size size_t  - size of the text
+    //! \return OutWriter&  - this writer
+	OutWriter& write(const char* text, size_t size);
+
+    //! \brief Write the null-terminated text
+    //!
+    //! \param text const char*  - text
+    //! \return OutWriter&  - this writer
+	OutWriter& write(const char* text)  { return write(text, strlen(text)); }
+
+    //! \brief Write the string
+    //!
+    //! \param text const string&  - text
+    //! \return OutWriter&  - this writer
+	OutWriter& write(const string& text)  { return write(text.data(), text.size()); }
+
+    //! \brief Write the unsigned integer value
+    //!
+    //! \param val uint64_t  - value
+    //! \return OutWriter&  - this writer
+	OutWriter& writeUInt(uint64_t val)
+	{
+		char  digits[20];
+		char*  pos = digits + sizeof digits;
+		do *--pos = '0' + val % 10;
+		while(val /= 10);
+		return write(pos, digits + sizeof digits - pos);
+	}
+
+    //! \brief Write the floating point value in the printf("%G") format
+    //!
+    //! \param val double  - value
+    //! \return OutWriter&  - this writer
+	OutWriter& writeFloat(double val);
+};
+
+#endif // FILEIO_H
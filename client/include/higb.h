@@ -0,0 +1,243 @@
+//! \brief Binary graph format (.higb) of the High Resolution Hierarchical Clustering with Stable State (HiReCS) client
+//! 	Stores the constructed nodes and links in CSR layout to be loaded without parsing
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+#ifndef HIGB_H
+#define HIGB_H
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>  // memcmp
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <system_error>
+#include "fileio.h"
+#include "hirecs.hpp"
+
+using std::string;
+using std::vector;
+using std::domain_error;
+using std::system_error;
+using std::system_category;
+using namespace hirecs;
+
+
+//! Signature of the .higb file
+constexpr char  HIGB_MAGIC[] = "HIGB";
+
+//! \brief Header of the .higb file
+//! \details The file layout (native byte order, all arrays are 8 byte aligned):
+//! 	HigbHeader
+//! 	Id  ids[nodes]  - external ids of the nodes
+//! 	float  sweights[nodes]  - self weights of the nodes
+//! 	uint64_t  offsets[nodes + 1]  - begin of the node links in dests (CSR)
+//! 	Id  dests[links]  - indices of the destination nodes in ids
+//! 	float  weights[links]  - weights of the links, only for the weighted graph
+//!
+//! The links are stored as they are in the finalized Graph, i.e. edges are
+//! already unfolded into the arcs and back links are present.
+struct HigbHeader {
+	char  magic[4];  //!< File signature, HIGB_MAGIC
+	uint16_t  version;  //!< Format version, VERSION
+	uint8_t  weighted;  //!< Whether the links are weighted
+	uint8_t  directed;  //!< Whether the links are directed (nonsymmetric)
+	uint64_t  nodes;  //!< Number of nodes
+	uint64_t  links;  //!< Number of links
+
+	constexpr static uint16_t  VERSION = 1;  //!< Current format version
+
+    //! \brief Whether the content starts with the .higb header
+    //!
+    //! \param data const char*  - content
+    //! \param size size_t  - size of the content
+    //! \return bool  - the content is .higb
+	static bool matches(const char* data, size_t size)
+	{
+		return size >= sizeof(HigbHeader) && !memcmp(data, HIGB_MAGIC, sizeof magic);
+	}
+};
+
+//! \brief Size of the array padded to 8 bytes
+//!
+//! \param num uint64_t  - number of items
+//! \param itemSize size_t  - size of the item
+//! \return uint64_t  - padded size in bytes
+inline uint64_t higbArraySize(uint64_t num, size_t itemSize)
+{
+	return (num * itemSize + 7) & ~uint64_t(7);
+}
+
+//! \brief Save finalized nodes into the .higb file
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \param filename const string&  - output filename
+//! \param nodes const NodesT&  - nodes to be saved
+//! \param directed bool  - whether the links are directed
+//! \return void
+template<bool WEIGHTED>
+void saveHigb(const string& filename, const typename Graph<WEIGHTED>::NodesT& nodes
+	, bool directed)
+{
+	using NodeT = typename Graph<WEIGHTED>::NodeT;
+	using WeightT = float;
+
+	// Index the nodes
+	const StoredItemsIndex<NodeT>  ndIdx(nodes);
+	HigbHeader  hdr;
+	memcpy(hdr.magic, HIGB_MAGIC, sizeof hdr.magic);
+	hdr.version = HigbHeader::VERSION;
+	hdr.weighted = WEIGHTED;
+	hdr.directed = directed;
+	hdr.nodes = nodes.size();
+	hdr.links = 0;
+	for(const auto& nd: nodes)
+		hdr.links += nd.links.size();
+
+	FILE*  fout = fopen(filename.c_str(), "wb");
+	if(!fout)
+		throw system_error(errno, system_category()
+			, "The file can't be created: " + filename);
+	const uint64_t  zero = 0;
+	// Write the array padding it to 8 bytes
+	auto writeArr = [fout, &zero, &filename](const void* data, uint64_t num, size_t itemSize) {
+		if(fwrite(data, itemSize, num, fout) != num
+		|| fwrite(&zero, 1, higbArraySize(num, itemSize) - num * itemSize, fout)
+			!= higbArraySize(num, itemSize) - num * itemSize)
+			throw system_error(errno, system_category()
+				, "The file can't be written: " + filename);
+	};
+	try {
+		writeArr(&hdr, 1, sizeof hdr);
+		// Node attributes
+		vector<Id>  ids;
+		ids.reserve(nodes.size());
+		vector<WeightT>  sweights;
+		sweights.reserve(nodes.size());
+		vector<uint64_t>  offsets;
+		offsets.reserve(nodes.size() + 1);
+		offsets.push_back(0);
+		for(const auto& nd: nodes) {
+			ids.push_back(nd.id);
+			sweights.push_back(nd.selfWeight());
+			offsets.push_back(offsets.back() + nd.links.size());
+		}
+		writeArr(ids.data(), ids.size(), sizeof(Id));
+		writeArr(sweights.data(), sweights.size(), sizeof(WeightT));
+		writeArr(offsets.data(), offsets.size(), sizeof(uint64_t));
+		ids = vector<Id>();
+		sweights = vector<WeightT>();
+		offsets = vector<uint64_t>();
+		// Links
+		vector<Id>  dests;
+		dests.reserve(hdr.links);
+		for(const auto& nd: nodes)
+			for(const auto& ln: nd.links)
+				dests.push_back(ndIdx.at(ln.dest));
+		writeArr(dests.data(), dests.size(), sizeof(Id));
+		if(WEIGHTED) {
+			dests = vector<Id>();
+			vector<WeightT>  weights;
+			weights.reserve(hdr.links);
+			for(const auto& nd: nodes)
+				for(const auto& ln: nd.links)
+					weights.push_back(ln.weight);
+			writeArr(weights.data(), weights.size(), sizeof(WeightT));
+		}
+	} catch(...) {
+		fclose(fout);
+		throw;
+	}
+	if(fclose(fout))
+		throw system_error(errno, system_category()
+			, "The file can't be written: " + filename);
+}
+
+//! \brief Validate and fetch header of the mapped .higb file
+//!
+//! \param file const MappedFile&  - mapped .higb content
+//! \return const HigbHeader&  - header of the file
+inline const HigbHeader& higbHeader(const MappedFile& file)
+{
+	if(!HigbHeader::matches(file.data(), file.size()))
+		throw domain_error("higbHeader(), the file is not in the .higb format\n");
+	const HigbHeader&  hdr = *reinterpret_cast<const HigbHeader*>(file.data());
+	if(hdr.version != HigbHeader::VERSION)
+		throw domain_error(std::to_string(hdr.version).insert(0
+			, "higbHeader(), unsupported version of the format: ") += '\n');
+	return hdr;
+}
+
+//! \brief Load nodes from the mapped .higb file
+//! 	Nodes are constructed with the exact capacity of links straight from
+//! 	the mapped arrays
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted, should correspond
+//! 	to the file header
+//! \param file const MappedFile&  - mapped .higb content
+//! \param nodes NodesT&  - nodes to be filled
+//! \return void
+template<bool WEIGHTED>
+void loadHigb(const MappedFile& file, typename Graph<WEIGHTED>::NodesT& nodes)
+{
+	using NodeT = typename Graph<WEIGHTED>::NodeT;
+	using WeightT = float;
+
+	const HigbHeader&  hdr = higbHeader(file);
+	if(hdr.weighted != WEIGHTED)
+		throw domain_error("loadHigb(), weighting of the links does not correspond to the file\n");
+	// Validate sizes of the arrays before locating them
+	// Note: each node and link takes at least 4 bytes in the file, which also
+	// prevents overflows of the sizes evaluation
+	const uint64_t  fsize = file.size();
+	if(hdr.nodes >= fsize / sizeof(uint32_t) || hdr.links >= fsize / sizeof(uint32_t)
+	|| higbArraySize(1, sizeof hdr) + 2 * higbArraySize(hdr.nodes, sizeof(Id))
+		+ higbArraySize(hdr.nodes + 1, sizeof(uint64_t))
+		+ (1 + WEIGHTED) * higbArraySize(hdr.links, sizeof(Id)) > fsize)
+		throw domain_error("loadHigb(), the file is truncated or corrupted\n");
+	static_assert(sizeof(Id) == sizeof(WeightT), "loadHigb(), the arrays sizes are evaluated"
+		" considering the same size of ids and weights");
+	// Locate arrays
+	const char*  pos = file.data() + higbArraySize(1, sizeof hdr);
+	const Id*  ids = reinterpret_cast<const Id*>(pos);
+	pos += higbArraySize(hdr.nodes, sizeof(Id));
+	const WeightT*  sweights = reinterpret_cast<const WeightT*>(pos);
+	pos += higbArraySize(hdr.nodes, sizeof(WeightT));
+	const uint64_t*  offsets = reinterpret_cast<const uint64_t*>(pos);
+	pos += higbArraySize(hdr.nodes + 1, sizeof(uint64_t));
+	const Id*  dests = reinterpret_cast<const Id*>(pos);
+	pos += higbArraySize(hdr.links, sizeof(Id));
+	const WeightT*  weights = reinterpret_cast<const WeightT*>(pos);
+	// Validate offsets: offsets[i] <= offsets[i+1] <= links
+	if(offsets[0] || offsets[hdr.nodes] != hdr.links)
+		throw domain_error("loadHigb(), the file is truncated or corrupted\n");
+	for(uint64_t i = 0; i < hdr.nodes; ++i)
+		if(offsets[i] > offsets[i + 1])
+			throw domain_error("loadHigb(), links offsets of the nodes are corrupted\n");
+
+	// Construct nodes with the exact links capacity
+	vector<NodeT*>  ndPtrs;
+	ndPtrs.reserve(hdr.nodes);
+	for(uint64_t i = 0; i < hdr.nodes; ++i) {
+		nodes.emplace_back(ids[i], offsets[i + 1] - offsets[i]);
+		nodes.back().selfWeight(sweights[i]);
+		ndPtrs.push_back(&nodes.back());
+	}
+	// Fill links
+	for(uint64_t i = 0; i < hdr.nodes; ++i)
+		for(auto j = offsets[i]; j < offsets[i + 1]; ++j) {
+			if(dests[j] >= hdr.nodes)
+				throw domain_error("loadHigb(), the link to unexistent node is used\n");
+			InpOperations<!WEIGHTED>::addLink(ndPtrs[i], ndPtrs[dests[j]]
+				, WEIGHTED ? weights[j] : 1);
+		}
+}
+
+#endif // HIGB_H
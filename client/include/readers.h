@@ -0,0 +1,716 @@
+//! \brief Readers of the input graph formats for the High Resolution Hierarchical Clustering with Stable State (HiReCS) client
+//! 	Input files are parsed in place and the links are streamed directly
+//! 	into the Graph without the intermediate conversion into .hig
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+#ifndef READERS_H
+#define READERS_H
+
+#include <cstring>  // memchr, strchr, strncmp, strspn
+#include <cctype>  // tolower
+#include <string>
+#include <vector>
+#include <limits>  // numeric_limits
+#include <algorithm>  // stable_sort, max
+#include <stdexcept>
+#include <type_traits>  // enable_if
+#include <utility>  // swap
+#include "fileio.h"
+#include "higb.h"  // HigbHeader
+#include "hirecs.hpp"
+
+using std::string;
+using std::vector;
+using std::numeric_limits;
+using std::domain_error;
+using std::out_of_range;
+using namespace hirecs;
+
+
+// Common helpers -------------------------------------------------------------
+//! \brief Form the input link
+//!
+//! \tparam InpLinkT  - input link type
+//! \param dst Id  - dest node id
+//! \param weight Weight  - link weight, omitted for the unweighted link
+//! \return InpLinkT  - input link
+template<typename InpLinkT>
+inline typename std::enable_if<InpLinkT::IS_WEIGHTED, InpLinkT>::type
+inpLink(Id dst, typename InpLinkT::Weight weight)
+{ return InpLinkT(dst, weight); }
+
+//! \copydoc inpLink
+template<typename InpLinkT>
+inline typename std::enable_if<!InpLinkT::IS_WEIGHTED, InpLinkT>::type
+inpLink(Id dst, typename InpLinkT::Weight weight)
+{ return InpLinkT(dst); }
+
+//! \brief Fetch the next significant line of the text
+//!
+//! \param line const char*&  - begin of the line, updated to the begin of the
+//! 	next line
+//! \param end const char*  - end of the text
+//! \param comments const char*  - symbols starting the comment lines
+//! \param lineEnd const char*&  - end of the fetched line
+//! \return const char*  - begin of the fetched line content (leading spaces
+//! 	are skipped) or nullptr if the text is over
+inline const char* nextLine(const char*& line, const char* end, const char* comments
+	, const char*& lineEnd)
+{
+	while(line != end) {
+		lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+		if(!lineEnd)
+			lineEnd = end;
+		const char*  pos = skipSpaces(line, lineEnd);
+		line = lineEnd != end ? lineEnd + 1 : end;
+		// Skip empty lines and comments
+		if(pos != lineEnd && !strchr(comments, *pos))
+			return pos;
+	}
+	return nullptr;
+}
+
+//! \brief Scan the id followed by a space or the line end
+//!
+//! \param pos const char*&  - position to start scanning, updated to the first
+//! 	symbol after the value
+//! \param lineEnd const char*  - end of the line
+//! \param id Id&  - resulting id
+//! \return bool  - whether the id is scanned
+inline bool scanIdItem(const char*& pos, const char* lineEnd, Id& id)
+{
+	return scanId(pos, lineEnd, id) && (pos == lineEnd || isSpace(*pos));
+}
+
+//! \brief Input arc (directed link) of the links section
+//!
+//! \tparam WeightT  - weight type
+template<typename WeightT>
+struct InpArc {
+	Id  src;  //!< Source node id
+	Id  dst;  //!< Dest node id
+	WeightT  weight;  //!< Link weight
+};
+
+//! \brief Resolve duplicated arcs, the last weight of the arc is used
+//! \post Arcs are ordered by src, dst
+//!
+//! \param arcs vector<InpArc<WeightT>>&  - arcs to be processed
+//! \return void
+template<typename WeightT>
+void resolveDuplicates(vector<InpArc<WeightT>>& arcs)
+{
+	std::stable_sort(arcs.begin(), arcs.end()
+		, [](const InpArc<WeightT>& a, const InpArc<WeightT>& b) {
+			return a.src < b.src || (a.src == b.src && a.dst < b.dst);
+		});
+	auto  iout = arcs.begin();
+	for(auto ia = arcs.begin(); ia != arcs.end(); ++ia) {
+		auto  ian = ia + 1;
+		if(ian == arcs.end() || ian->src != ia->src || ian->dst != ia->dst)
+			*iout++ = *ia;
+	}
+	arcs.erase(iout, arcs.end());
+}
+
+//! \brief Batch of the links of a source node being added to the Graph
+//! 	Consecutive links of the same source node and direction are added by
+//! 	a single call reusing the links buffer, which avoids allocations and
+//! 	repeated lookups of the source node
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+template<bool WEIGHTED>
+class LinksBatch {
+public:
+	using GraphT = Graph<WEIGHTED>;  //!< \copydoc Graph<WEIGHTED>
+	using InpLinkT = typename GraphT::InpLinkT;  //!< \copydoc GraphT::InpLinkT
+private:
+	GraphT*  m_graph;  // Graph to be extended
+	bool  m_create;  // Create unexistent nodes of the links
+	bool  m_directed;  // Whether the links are directed
+	Id  m_src;  // Source node of the links
+	typename GraphT::InpLinksT  m_links;  // Buffered links
+public:
+	LinksBatch(): m_graph(nullptr), m_create(false), m_directed(false), m_src(ID_NONE)
+	, m_links()  {}
+
+    //! \brief Assign the graph to be extended
+    //!
+    //! \param graph GraphT&  - graph to be extended
+    //! \param create bool  - create nodes of the links instead of requiring
+    //! 	them to be existent
+    //! \return void
+	void graph(GraphT& graph, bool create)
+	{
+		m_graph = &graph;
+		m_create = create;
+	}
+
+    //! \brief Whether the graph is assigned
+    //!
+    //! \return bool  - the graph is assigned
+	bool hasGraph() const  { return m_graph; }
+
+    //! \brief Add the link
+    //!
+    //! \param src Id  - source node id
+    //! \param link const InpLinkT&  - link
+    //! \param directed bool  - whether the link is directed
+    //! \return void
+	void add(Id src, const InpLinkT& link, bool directed)
+	{
+		if(src != m_src || directed != m_directed)
+			flush();
+		m_src = src;
+		m_directed = directed;
+		m_links.push_back(link);
+	}
+
+    //! \brief Add the buffered links to the graph
+    //!
+    //! \return void
+	void flush()
+	{
+		if(m_links.empty())
+			return;
+		if(m_create) {
+			if(m_directed)
+				m_graph->template addNodeAndLinks<true>(m_src, m_links);
+			else m_graph->template addNodeAndLinks<false>(m_src, m_links);
+		} else if(m_directed)
+			m_graph->template addNodeLinks<true>(m_src, m_links);
+		else m_graph->template addNodeLinks<false>(m_src, m_links);
+		m_links.clear();
+	}
+};
+
+//! \brief Links buffered in the flat arrays to be added to the Graph in bulk
+//! 	by Graph::addEdges(), which allocates links of each node once
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+template<bool WEIGHTED>
+struct LinksArrays {
+	using GraphT = Graph<WEIGHTED>;  //!< \copydoc Graph<WEIGHTED>
+	using Weight = typename GraphT::InpLinkT::Weight;  //!< \copydoc InpLinkT::Weight
+
+	vector<Id>  srcs;  //!< Source node ids
+	vector<Id>  dsts;  //!< Dest node ids
+	vector<Weight>  weights;  //!< Links weights, empty for the unweighted links
+
+	LinksArrays(): srcs(), dsts(), weights()  {}
+
+    //! \brief Add the link
+    //!
+    //! \param src Id  - source node id
+    //! \param dst Id  - dest node id
+    //! \param weight Weight  - link weight, omitted for the unweighted links
+    //! \return void
+	void add(Id src, Id dst, Weight weight)
+	{
+		srcs.push_back(src);
+		dsts.push_back(dst);
+		if(WEIGHTED)
+			weights.push_back(weight);
+	}
+
+    //! \brief Add the buffered links to the graph releasing the buffer
+    //!
+    //! \param graph GraphT&  - graph to be extended
+    //! \param directed bool  - whether the links are directed
+    //! \param create bool  - create nodes of the links instead of requiring
+    //! 	them to be existent
+    //! \param threads unsigned  - number of threads
+    //! \return void
+	void flush(GraphT& graph, bool directed, bool create, unsigned threads)
+	{
+		const Weight*  lws = weights.empty() ? nullptr : weights.data();
+		if(directed)
+			graph.template addEdges<true>(srcs.data(), dsts.data(), lws, srcs.size()
+				, create, threads);
+		else graph.template addEdges<false>(srcs.data(), dsts.data(), lws, srcs.size()
+			, create, threads);
+		srcs = vector<Id>();
+		dsts = vector<Id>();
+		weights = vector<Weight>();
+	}
+};
+
+// Input format detection -----------------------------------------------------
+//! Input graph format
+enum class InputFormat: uint8_t {
+	HIG,  //!< .hig, HiReCS input graph
+	HIGB,  //!< .higb, binary HiReCS graph
+	PAJEK,  //!< .net, Pajek
+	EDGELIST,  //!< .el, SNAP-like edge list: <src> <dst> [<weight>] per line
+	METIS,  //!< .graph, METIS adjacency lists
+	MTX  //!< .mtx, Matrix Market coordinate matrix
+};
+
+//! \brief Input format by its name (the file extension)
+//!
+//! \param name const string&  - format name: hig, higb, net (pjk, paj),
+//! 	el (edges, snap), graph (metis), mtx
+//! \return InputFormat  - input format
+inline InputFormat inputFormat(const string& name)
+{
+	string  fmt = name;
+	for(auto& c: fmt)
+		c = tolower(c);
+	if(fmt == "hig")
+		return InputFormat::HIG;
+	if(fmt == "higb")
+		return InputFormat::HIGB;
+	if(fmt == "net" || fmt == "pjk" || fmt == "paj")
+		return InputFormat::PAJEK;
+	if(fmt == "el" || fmt == "edges" || fmt == "snap")
+		return InputFormat::EDGELIST;
+	if(fmt == "graph" || fmt == "metis")
+		return InputFormat::METIS;
+	if(fmt == "mtx")
+		return InputFormat::MTX;
+	throw out_of_range(fmt.insert(0, "Unknown input format: ") += '\n');
+}
+
+//! Header of the Matrix Market file
+constexpr char  MTX_BANNER[] = "%%MatrixMarket";
+
+//! \brief Detect format of the input graph
+//! 	The binary and Matrix Market formats are identified by the signature,
+//! 	METIS by the file extension (it is indistinguishable from the edge list
+//! 	by content), .hig and Pajek by the first significant line, edge lists
+//! 	by the file extension (el, edges, snap) only
+//! \note domain_error is thrown if the format is not recognized, so arbitrary
+//! 	columnar files are not taken as edge lists implicitly
+//!
+//! \param file const MappedFile&  - mapped input file
+//! \param filename const string&  - input file name
+//! \return InputFormat  - input format
+inline InputFormat inputFormat(const MappedFile& file, const string& filename)
+{
+	if(HigbHeader::matches(file.data(), file.size()))
+		return InputFormat::HIGB;
+	if(file.size() >= sizeof MTX_BANNER - 1
+	&& !strncmp(file.data(), MTX_BANNER, sizeof MTX_BANNER - 1))
+		return InputFormat::MTX;
+	string  ext;  // File extension in lower case
+	auto  iext = filename.rfind('.');
+	if(iext != string::npos && filename.find('/', iext) == string::npos) {
+		ext = filename.substr(iext + 1);
+		for(auto& c: ext)
+			c = tolower(c);
+		if(ext == "graph" || ext == "metis")
+			return InputFormat::METIS;
+	}
+	const char*  line = file.data();
+	const char*  lineEnd;
+	const char*  pos = nextLine(line, file.end(), "#%", lineEnd);
+	if((pos && *pos == '/') || ext == "hig")
+		return InputFormat::HIG;
+	if(pos && *pos == '*')
+		return InputFormat::PAJEK;
+	if(ext == "el" || ext == "edges" || ext == "snap")
+		return InputFormat::EDGELIST;
+	throw domain_error("The input format is not recognized: " + filename
+		+ ", it should be specified by -i<format>\n");
+}
+
+// Pajek format ---------------------------------------------------------------
+//! \brief Load the graph from the mapped Pajek file
+//! 	Format: http://gephi.github.io/users/supported-graph-formats/pajek-net-format/
+//! 	*Vertices should be the first section (*Network can precede it),
+//! 	its annotations are skipped. Nodes ids are [1, vertices].
+//! 	Links are specified in the *Edges, *Arcs (one link per line with the
+//! 	optional weight) and *Edgeslist, *Arcslist (unweighted links of the node
+//! 	per line) sections.
+//! \note Self links of *Edges are added as undirected ones like in .hig and
+//! 	the other formats
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \param file const MappedFile&  - mapped Pajek content
+//! \param resdub bool  - resolve duplicated links in *Edges, *Arcs sections,
+//! 	the last weight of the link is used
+//! \param makeGraph GraphOpT  - operation creating the Graph by the number of
+//! 	nodes: Graph<WEIGHTED>& makeGraph(Id nodesNum, Id startId)
+//! \return void
+template<bool WEIGHTED, typename GraphOpT>
+void loadPajek(const MappedFile& file, bool resdub, GraphOpT makeGraph)
+{
+	using InpLinkT = typename Graph<WEIGHTED>::InpLinkT;
+	using Weight = typename InpLinkT::Weight;
+	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;
+	constexpr Weight  DEFAULT_WEIGHT = SimpleLink<typename Graph<WEIGHTED>::LinkT::WeightType>::weight;
+
+	enum class Section {
+		NONE,
+		VERTICES,
+		EDGES,  // Undirected link per line
+		ARCS,  // Directed link per line
+		EDGESLIST,  // Undirected links of the node per line
+		ARCSLIST  // Directed links of the node per line
+	};
+
+	Section  sect = Section::NONE;
+	LinksBatch<WEIGHTED>  batch;
+	vector<InpArc<Weight>>  sectArcs;  // Links of the section to resolve duplicates
+
+	// Add link of the *Edges, *Arcs sections to the graph
+	auto addLink = [&sect, &batch](Id src, Id dst, Weight weight) {
+		batch.add(src, inpLink<InpLinkT>(dst, weight), sect == Section::ARCS);
+	};
+	// Add links of the section resolving duplicates
+	auto flushSection = [&]() {
+		if(!sectArcs.empty()) {
+			resolveDuplicates(sectArcs);
+			for(const auto& arc: sectArcs)
+				addLink(arc.src, arc.dst, arc.weight);
+			sectArcs = vector<InpArc<Weight>>();
+		}
+		batch.flush();
+	};
+
+	const char*  end = file.end();
+	const char*  lineEnd;
+	for(const char *line = file.data(), *pos; (pos = nextLine(line, end, "%", lineEnd));) {
+		if(*pos == '*') {
+			// Process section header
+			flushSection();
+			const char*  pose = ++pos;
+			while(pose != lineEnd && !isSpace(*pose))
+				++pose;
+			string  title(pos, pose);
+			for(auto& c: title)
+				c = tolower(c);
+			if(title == "network") {
+				if(sect != Section::NONE)
+					throw domain_error("Unexpected Pajek section: *Network should be the first one\n");
+				continue;
+			}
+			if(title == "vertices") {
+				if(sect != Section::NONE)
+					throw domain_error("Unexpected Pajek section: *Vertices should be the first one\n");
+				pos = skipSpaces(pose, lineEnd);
+				Id  nodesNum;
+				if(!scanId(pos, lineEnd, nodesNum))
+					throw domain_error("Number of the Pajek vertices must be specified\n");
+				batch.graph(makeGraph(nodesNum, 1), false);
+				sect = Section::VERTICES;
+				continue;
+			}
+			if(sect == Section::NONE)
+				throw domain_error("Unexpected Pajek section: *Vertices is expected first\n");
+			if(title == "edges")
+				sect = Section::EDGES;
+			else if(title == "arcs")
+				sect = Section::ARCS;
+			else if(title == "edgeslist")
+				sect = Section::EDGESLIST;
+			else if(title == "arcslist")
+				sect = Section::ARCSLIST;
+			else throw out_of_range(title.insert(0, "Unknown Pajek section is used: ") += '\n');
+			continue;
+		}
+
+		// Process section body
+		if(sect == Section::NONE)
+			throw domain_error("Invalid Pajek format: section header is expected\n");
+		if(sect == Section::VERTICES)
+			continue;  // Skip vertices annotations
+		const char*  ln = pos;
+		Id  src;
+		if(!scanIdItem(pos, lineEnd, src) || pos == lineEnd)
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		if(sect == Section::EDGES || sect == Section::ARCS) {
+			Id  dst;
+			pos = skipSpaces(pos, lineEnd);
+			if(!scanIdItem(pos, lineEnd, dst))
+				throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+			Weight  weight = DEFAULT_WEIGHT;
+			pos = skipSpaces(pos, lineEnd);
+			if(pos != lineEnd) {
+				// Note: the weight is validated but omitted for the unweighted graph
+				Weight  val;
+				if(!scanFloat(pos, lineEnd, val))
+					throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+				if(WEIGHTED)
+					weight = val;
+				// Only the dest and weight are expected
+				pos = skipSpaces(pos, lineEnd);
+				if(pos != lineEnd)
+					throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+			}
+			if(resdub)
+				sectArcs.push_back(InpArc<Weight>{src, dst, weight});
+			else addLink(src, dst, weight);
+		} else {
+			// Lists of the unweighted links
+			const bool  directed = sect == Section::ARCSLIST;
+			while((pos = skipSpaces(pos, lineEnd)) != lineEnd) {
+				Id  dst;
+				if(!scanIdItem(pos, lineEnd, dst))
+					throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+				batch.add(src, inpLink<InpLinkT>(dst, DEFAULT_WEIGHT), directed);
+			}
+		}
+	}
+	if(!batch.hasGraph())
+		throw domain_error("Invalid Pajek format: *Vertices section is absent\n");
+	flushSection();
+}
+
+// Edge list format -----------------------------------------------------------
+//! \brief Load the graph from the mapped edge list (SNAP-like) file
+//! 	Format: <src_id> <dst_id> [<weight>] per line, '#' and '%' start
+//! 	the comment lines. Nodes are created from the links.
+//! \note The third column is the weight only if it is requested explicitly,
+//! 	since SNAP edge lists often have timestamps there
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \param file const MappedFile&  - mapped edge list content
+//! \param directed bool  - whether the links are directed (arcs) or undirected
+//! 	(edges)
+//! \param lnweighted bool  - the third column is the link weight, otherwise
+//! 	the remained columns are omitted
+//! \param resdub bool  - resolve duplicated links, the last weight of the link
+//! 	is used. Opposite undirected links are also duplicates
+//! \param makeGraph GraphOpT  - operation creating the Graph by the number of
+//! 	nodes: Graph<WEIGHTED>& makeGraph(Id nodesNum, Id startId)
+//! \param threads=1 unsigned  - number of threads to add links to the Graph
+//! \return void
+template<bool WEIGHTED, typename GraphOpT>
+void loadEdgeList(const MappedFile& file, bool directed, bool lnweighted, bool resdub
+	, GraphOpT makeGraph, unsigned threads=1)
+{
+	using InpLinkT = typename Graph<WEIGHTED>::InpLinkT;
+	using Weight = typename InpLinkT::Weight;
+	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;
+	constexpr Weight  DEFAULT_WEIGHT = SimpleLink<typename Graph<WEIGHTED>::LinkT::WeightType>::weight;
+
+	// Note: the number of nodes is unknown, they are created from the links
+	auto&  graph = makeGraph(0, ID_NONE);
+	LinksArrays<WEIGHTED>  links;
+	vector<InpArc<Weight>>  arcs;  // Links to resolve duplicates
+
+	const char*  end = file.end();
+	const char*  lineEnd;
+	for(const char *line = file.data(), *pos; (pos = nextLine(line, end, "#%", lineEnd));) {
+		const char*  ln = pos;
+		Id  src;
+		Id  dst;
+		if(!scanIdItem(pos, lineEnd, src) || pos == lineEnd)
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		pos = skipSpaces(pos, lineEnd);
+		if(!scanIdItem(pos, lineEnd, dst))
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		Weight  weight = DEFAULT_WEIGHT;
+		pos = skipSpaces(pos, lineEnd);
+		// Note: the remained columns (timestamps, etc.) are omitted
+		if(WEIGHTED && lnweighted && pos != lineEnd && !scanFloat(pos, lineEnd, weight))
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		if(resdub) {
+			if(!directed && src > dst)
+				std::swap(src, dst);
+			arcs.push_back(InpArc<Weight>{src, dst, weight});
+		} else links.add(src, dst, weight);
+	}
+	if(resdub) {
+		resolveDuplicates(arcs);
+		for(const auto& arc: arcs)
+			links.add(arc.src, arc.dst, arc.weight);
+		arcs = vector<InpArc<Weight>>();
+	}
+	links.flush(graph, directed, true, threads);
+}
+
+// METIS format ---------------------------------------------------------------
+//! \brief Load the graph from the mapped METIS file
+//! 	Format: header <nodes> <edges> [<fmt> [<ncon>]], then adjacency list of
+//! 	each node per line: [<size>] [<vweight_1> .. <vweight_ncon>]
+//! 	<dst_id> [<weight>] ... Where fmt digits denote existence of the node
+//! 	sizes, node weights and link weights. '%' starts the comment lines.
+//! 	Nodes ids are [1, nodes], node sizes and weights are omitted.
+//! \note Each undirected link is listed by both nodes, so it is added once
+//! 	from the node with the lower id
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \param file const MappedFile&  - mapped METIS content
+//! \param makeGraph GraphOpT  - operation creating the Graph by the number of
+//! 	nodes: Graph<WEIGHTED>& makeGraph(Id nodesNum, Id startId)
+//! \return void
+template<bool WEIGHTED, typename GraphOpT>
+void loadMetis(const MappedFile& file, GraphOpT makeGraph)
+{
+	using InpLinkT = typename Graph<WEIGHTED>::InpLinkT;
+	using Weight = typename InpLinkT::Weight;
+	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;
+	constexpr Weight  DEFAULT_WEIGHT = SimpleLink<typename Graph<WEIGHTED>::LinkT::WeightType>::weight;
+
+	const char*  end = file.end();
+	const char*  line = file.data();
+	const char*  lineEnd;
+	const char*  pos = nextLine(line, end, "%", lineEnd);
+	// Parse the header
+	Id  nodesNum;
+	Id  edgesNum;
+	if(!pos || !scanIdItem(pos, lineEnd, nodesNum)
+	|| !scanIdItem(pos = skipSpaces(pos, lineEnd), lineEnd, edgesNum))
+		throw domain_error("Invalid METIS format: <nodes> <edges> header is expected\n");
+	bool  lnweighted = false;  // Links are weighted
+	Id  ndvals = 0;  // Number of the node values (size and weights) to be skipped
+	if((pos = skipSpaces(pos, lineEnd)) != lineEnd) {
+		const char*  fmt = pos;
+		while(pos != lineEnd && !isSpace(*pos))
+			++pos;
+		if(pos - fmt > 3 || strspn(fmt, "01") < size_t(pos - fmt))
+			throw invalidValueFormat(fmt, lineEnd, fmt, SYM_DIGITS_MAX);
+		// Note: fmt is the binary flags aligned to the right
+		const string  flags = string(3 - (pos - fmt), '0').append(fmt, pos);
+		lnweighted = flags[2] == '1';
+		ndvals = flags[0] == '1';
+		if(flags[1] == '1') {
+			Id  ncon = 1;
+			if((pos = skipSpaces(pos, lineEnd)) != lineEnd
+			&& !scanIdItem(pos, lineEnd, ncon))
+				throw invalidValueFormat(fmt, lineEnd, pos, SYM_DIGITS_MAX);
+			ndvals += ncon;
+		}
+	}
+
+	LinksBatch<WEIGHTED>  batch;
+	batch.graph(makeGraph(nodesNum, 1), false);
+	// Note: empty lines are significant here (nodes without links)
+	for(Id src = 1; src <= nodesNum; ++src) {
+		if(line == end)
+			throw domain_error("Invalid METIS format: the file is truncated\n");
+		lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+		if(!lineEnd)
+			lineEnd = end;
+		const char*  ln = line;
+		pos = skipSpaces(line, lineEnd);
+		line = lineEnd != end ? lineEnd + 1 : end;
+		if(pos != lineEnd && *pos == '%') {
+			--src;  // Comment line
+			continue;
+		}
+		// Skip the node values
+		for(Id i = 0; i < ndvals; ++i) {
+			Weight  val;
+			if(!scanFloat(pos, lineEnd, val))
+				throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+			pos = skipSpaces(pos, lineEnd);
+		}
+		// Fetch the links
+		while((pos = skipSpaces(pos, lineEnd)) != lineEnd) {
+			Id  dst;
+			if(!scanIdItem(pos, lineEnd, dst))
+				throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+			Weight  weight = DEFAULT_WEIGHT;
+			if(lnweighted) {
+				pos = skipSpaces(pos, lineEnd);
+				Weight  val;
+				if(!scanFloat(pos, lineEnd, val))
+					throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+				if(WEIGHTED)
+					weight = val;
+			}
+			if(dst > src)
+				batch.add(src, inpLink<InpLinkT>(dst, weight), false);
+		}
+	}
+	batch.flush();
+}
+
+// Matrix Market format -------------------------------------------------------
+//! \brief Load the graph from the mapped Matrix Market file
+//! 	Format: http://math.nist.gov/MatrixMarket/formats.html
+//! 	Only the coordinate real, integer and pattern matrices are supported.
+//! 	Nodes ids are [1, max(rows, cols)]. Entries of the general matrix are
+//! 	arcs, entries of the symmetric matrix are edges (diagonal entries are
+//! 	self weights).
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \param file const MappedFile&  - mapped Matrix Market content
+//! \param resdub bool  - resolve duplicated entries, the last value is used
+//! \param makeGraph GraphOpT  - operation creating the Graph by the number of
+//! 	nodes: Graph<WEIGHTED>& makeGraph(Id nodesNum, Id startId)
+//! \param threads=1 unsigned  - number of threads to add links to the Graph
+//! \return void
+template<bool WEIGHTED, typename GraphOpT>
+void loadMtx(const MappedFile& file, bool resdub, GraphOpT makeGraph, unsigned threads=1)
+{
+	using InpLinkT = typename Graph<WEIGHTED>::InpLinkT;
+	using Weight = typename InpLinkT::Weight;
+	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;
+	constexpr Weight  DEFAULT_WEIGHT = SimpleLink<typename Graph<WEIGHTED>::LinkT::WeightType>::weight;
+
+	const char*  end = file.end();
+	const char*  line = file.data();
+	const char*  lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+	if(!lineEnd)
+		lineEnd = end;
+	// Parse the banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+	string  banner(line, lineEnd);
+	for(auto& c: banner)
+		c = tolower(c);
+	line = lineEnd != end ? lineEnd + 1 : end;
+	vector<string>  attrs;
+	for(size_t pos = 0; (pos = banner.find_first_not_of(" \t\r", pos)) != string::npos;) {
+		size_t  pose = banner.find_first_of(" \t\r", pos);
+		attrs.push_back(banner.substr(pos, pose - pos));
+		pos = pose;
+	}
+	if(attrs.size() != 5 || attrs[1] != "matrix" || attrs[2] != "coordinate"
+	|| (attrs[3] != "real" && attrs[3] != "integer" && attrs[3] != "pattern")
+	|| (attrs[4] != "general" && attrs[4] != "symmetric"))
+		throw domain_error(banner.insert(0, "Unsupported Matrix Market format: ") += '\n');
+	const bool  valued = attrs[3] != "pattern";
+	const bool  directed = attrs[4] == "general";
+
+	// Parse the size: <rows> <cols> <entries>
+	const char*  pos = nextLine(line, end, "%", lineEnd);
+	Id  rows;
+	Id  cols;
+	if(!pos || !scanIdItem(pos, lineEnd, rows)
+	|| !scanIdItem(pos = skipSpaces(pos, lineEnd), lineEnd, cols))
+		throw domain_error("Invalid Matrix Market format: <rows> <cols> <entries> are expected\n");
+
+	auto&  graph = makeGraph(std::max(rows, cols), 1);
+	LinksArrays<WEIGHTED>  links;
+	vector<InpArc<Weight>>  arcs;  // Links to resolve duplicates
+	while((pos = nextLine(line, end, "%", lineEnd))) {
+		const char*  ln = pos;
+		Id  src;
+		Id  dst;
+		if(!scanIdItem(pos, lineEnd, src) || pos == lineEnd)
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		pos = skipSpaces(pos, lineEnd);
+		if(!scanIdItem(pos, lineEnd, dst))
+			throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+		Weight  weight = DEFAULT_WEIGHT;
+		if(valued) {
+			pos = skipSpaces(pos, lineEnd);
+			Weight  val;
+			if(!scanFloat(pos, lineEnd, val))
+				throw invalidValueFormat(ln, lineEnd, pos, SYM_DIGITS_MAX);
+			if(WEIGHTED)
+				weight = val;
+		}
+		if(resdub)
+			arcs.push_back(InpArc<Weight>{src, dst, weight});
+		else links.add(src, dst, weight);
+	}
+	if(resdub) {
+		resolveDuplicates(arcs);
+		for(const auto& arc: arcs)
+			links.add(arc.src, arc.dst, arc.weight);
+		arcs = vector<InpArc<Weight>>();
+	}
+	links.flush(graph, directed, false, threads);
+}
+
+#endif // READERS_H
@@ -8,40 +8,31 @@
 //! \email luart@ya.ru
 //! \date 2014-11-02
 #include <cstdio>
+#include <cstring>  // memchr
+#include <cstddef>  // ptrdiff_t
+#include <ctime>  // time
+#include <chrono>  // steady_clock
 #include <utility>  // make_pair
-#include <iostream>  // Input file processing
-#include <fstream>
 #include <limits>  //  numeric_limits
+#include <atomic>  // Links counting
 #include <stdexcept>  // Arguments processing
+#include "parallel.h"
+#include "fileio.h"  // Input file processing
+#include "higb.h"
+#include "readers.h"
 #include "client.h"
 
 using std::vector;
 using std::pair;
+using std::atomic;
 using std::move;
-using std::ifstream;
 using std::domain_error;
 using std::invalid_argument;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 
 
 // Formatting helpers ---------------------------------------------------------
-template<typename ItemsT>
-string itemsToStr(const ItemsT& els, char delim=' ', bool strict=false
-	, const string& prefix="", const string& suffix="")
-{
-	string str;
-
-	if(!els.empty()) {
-		str = prefix;
-		for(auto c: els)
-			str += to_string(c->id) += delim;
-		str.pop_back();
-		str += suffix;
-	} else if(!strict)
-		str = "-";
-
-	return str;
-}
-
 template<typename LinksT>
 string linksToStr(const LinksT& ls)
 {
@@ -55,11 +46,40 @@ string linksToStr(const LinksT& ls)
 	return str;
 }
 
-//! \brief Prints cluster links to stdout
+//! \brief Write ids of the items
+//!
+//! \param out OutWriter&  - output writer
+//! \param els const ItemsT&  - items (pointers to the clusters / nodes)
+//! \param delim=' ' char  - delimiter of the ids
+//! \param strict=false bool  - write nothing for the empty items instead of "-"
+//! \param prefix=nullptr const char*  - prefix of the nonempty items
+//! \param suffix=nullptr const char*  - suffix of the nonempty items
+//! \return void
+template<typename ItemsT>
+void writeItems(OutWriter& out, const ItemsT& els, char delim=' ', bool strict=false
+	, const char* prefix=nullptr, const char* suffix=nullptr)
+{
+	if(!els.empty()) {
+		if(prefix)
+			out.write(prefix);
+		bool  first = true;
+		for(auto c: els) {
+			if(!first)
+				out.put(delim);
+			out.writeUInt(c->id);
+			first = false;
+		}
+		if(suffix)
+			out.write(suffix);
+	} else if(!strict)
+		out.put('-');
+}
+
+//! \brief Writes cluster links to the output
 //!
 //! \param cl ClusterT&  - cluster to be processed
 //! \param initial=false bool  - initial (first call) for the current level
-//! \param params=nullptr void  - additional processing parameters
+//! \param params=nullptr void  - output writer (OutWriter*)
 //! \return void
 template<typename ClusterT>
 void outpClsLinksJSON(ClusterT& cl, bool initial=false, void* params=nullptr)
@@ -72,16 +92,18 @@ void outpClsLinksJSON(ClusterT& cl, bool initial=false, void* params=nullptr)
 	//		}, ...
 	//	}, ...
 	//]
-	printf(!initial ? ",{\"%u\":{" : "{\"%u\":{", cl.id);
+	OutWriter&  out = *static_cast<OutWriter*>(params);
+	out.write(!initial ? ",{\"" : "{\"").writeUInt(cl.id).write("\":{");
 	// Output selfweight as separate link, as first item if exists
 	size_t  i = 0;
 	if(cl.selfWeight()) {
-		printf("\"%u\":%G", cl.id, cl.selfWeight());
+		out.put('"').writeUInt(cl.id).write("\":").writeFloat(cl.selfWeight());
 		++i;
 	}
 	for(const auto& ln: cl.links)
-		printf(i++ ? ",\"%u\":%G" : "\"%u\":%G", ln.dest->id, ln.weight);
-	fputs("}}", stdout);
+		out.write(i++ ? ",\"" : "\"").writeUInt(ln.dest->id).write("\":")
+			.writeFloat(ln.weight);
+	out.write("}}");
 }
 
 // Input arguments processing -------------------------------------------------
@@ -93,7 +115,8 @@ void classifyArgs(int argc, char* argv[], vector<string>& opts, vector<string>&
 		return;
 
 	for(auto i = 1; i < argc; ++i) {
-		if(argv[i][0] == '-')
+		// Note: "-" denotes stdin
+		if(argv[i][0] == '-' && argv[i][1])
 			opts.push_back(argv[i] + 1);  // Skip '-'
 		else files.push_back(argv[i]);
 	}
@@ -136,8 +159,11 @@ void Operations<true>::addLink(Links<LinkT>& links, Id id, WeightT weight)
 // Client implementation ------------------------------------------------------
 template<typename LinksT>
 void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
-	, bool fast, float modProfitMarg, char outfmt, uint8_t extoutp)
+	, bool fast, float modProfitMarg, char outfmt, uint8_t extoutp, unsigned threads
+	, const string& outfile, NodesOrder order)
 {
+	// Note: the output is opened before the clustering to fail early
+	OutWriter  out(outfile);
 	// Output input data
 #ifdef DEBUG
 	fprintf(stderr, "-Nodes:\n");
@@ -145,7 +171,22 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 		fprintf(stderr, "-Node #%2u: %s\n", n.id, linksToStr(n.links).c_str());
 	fprintf(stderr, "\n");
 #endif  // DEBUG
-	auto hier = cluster(move(nodes), symmetric, validate, fast, modProfitMarg);
+	if(order != NodesOrder::NONE) {
+		const double  span = linksSpan(nodes, threads);
+		const auto  tstart = steady_clock::now();
+		orderNodes(nodes, order, threads);
+		const duration<double>  dt = steady_clock::now() - tstart;
+		fprintf(stderr, "-Nodes are reordered in %.3f sec, mean links span: %.1f -> %.1f\n"
+			, dt.count(), span, linksSpan(nodes, threads));
+	}
+	// Note: links are validated and fixed concurrently in bulk here, so the
+	// clustering skips the validation
+	if(validate) {
+		const auto  lval = validateLinks(nodes, threads);
+		fprintf(stderr, "-Links are validated, nodes: %lu, links: %lu, removed duplicates: %lu"
+			", added back links: %lu\n", lval.nodes, lval.links, lval.duplicates, lval.backLinks);
+	}
+	auto hier = cluster(move(nodes), symmetric, false, fast, modProfitMarg);
 
 	// Output result
 	using ClusterItemsT = typename decltype(hier)::element_type::ClusterItemsT;
@@ -156,24 +197,26 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 
 	if(outfmt == 't') {
 		// Text format for log files
-		printf("\n -Clusters:\n");
+		out.write("\n -Clusters:\n");
 		for(Id i = 0; !lev.empty(); ++i) {
 			RawLevel  nlev;
-			printf("----- Clusers level #%u -------------------------------------------------------\n", i);
+			out.write("----- Clusers level #").writeUInt(i)
+				.write(" -------------------------------------------------------\n");
 			for(const auto& g: lev) {
 //				if(g.second.empty())
 //					continue;
-				printf("-- Sibling nodes OCl #%u --------------------------------------------\n", g.first);
+				out.write("-- Sibling nodes OCl #").writeUInt(g.first)
+					.write(" --------------------------------------------\n");
 				for(auto c: g.second) {
-					printf("-Cluster #%u  ownersNum: %lu\n\towners: %s\n\tdes %s\n%s"
-						, c->id, c->owners.size()
-						, itemsToStr(c->owners).c_str()
-						, itemsToStr(c->des, ' ', true, c->des.front()->descs()
-							? "(cls): " : "(nds): " ).c_str()
-						, c->des.front()->core() ? (string("\tcore: ")
-							+= to_string(c->des.front()->core()->id).append("\n"))
-							.c_str() : ""
-					);
+					out.write("-Cluster #").writeUInt(c->id).write("  ownersNum: ")
+						.writeUInt(c->owners.size()).write("\n\towners: ");
+					writeItems(out, c->owners);
+					out.write("\n\tdes ");
+					writeItems(out, c->des, ' ', true, c->des.front()->descs()
+						? "(cls): " : "(nds): ");
+					out.put('\n');
+					if(c->des.front()->core())
+						out.write("\tcore: ").writeUInt(c->des.front()->core()->id).put('\n');
 					if(c->des.front()->descs())
 						nlev.emplace(c->id, (ClusterItemsT&)c->des);
 				}
@@ -182,30 +225,29 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 			nlev.clear();
 		}
 		// Write summary
-		printf("-Nodes: %lu, clusers (communities): %lu, roots: %lu, mod: %G\n"
-			, hier->nodes().size(), hier->clusters().size(), hier->root().size()
-			, hier->score().modularity);
+		out.write("-Nodes: ").writeUInt(hier->nodes().size())
+			.write(", clusers (communities): ").writeUInt(hier->clusters().size())
+			.write(", roots: ").writeUInt(hier->root().size())
+			.write(", mod: ").writeFloat(hier->score().modularity).put('\n');
 	} else {
 		if(outfmt != 'c' && outfmt != 'j')
 			throw domain_error("processNodes(), unexpected output format\n");
 
 		if(outfmt == 'j') {
 			// JSON format
-			// Note: puts() appends newline implicitly, that is why fputs is used
-			fputs(itemsToStr(hier->root(), ',', true, "{\"root\":[", "],\"clusters\":{").c_str(), stdout);
+			writeItems(out, hier->root(), ',', true, "{\"root\":[", "],\"clusters\":{");
 			size_t  j = 0;
-			for(const auto& c: hier->clusters())
-				printf("%s\"%u\":{%s%s%s%s}"
-					, j++ ? "," : "", c.id
-					, (!c.owners.empty()
-						? itemsToStr(c.owners, ',', true, "\"owners\":[", "],").c_str()
-						: "")
-					, itemsToStr(c.des, ',', true, "\"des\":[", "]").c_str()
-					, c.des.front()->descs() ? "" : ",\"leafs\":true"
-					, c.des.front()->core() ? (string(",\"core\":")
-						+= to_string(c.des.front()->core()->id)).c_str() : ""
-				);
-			putchar('}');
+			for(const auto& c: hier->clusters()) {
+				out.write(j++ ? ",\"" : "\"").writeUInt(c.id).write("\":{");
+				writeItems(out, c.owners, ',', true, "\"owners\":[", "],");
+				writeItems(out, c.des, ',', true, "\"des\":[", "]");
+				if(!c.des.front()->descs())
+					out.write(",\"leafs\":true");
+				if(c.des.front()->core())
+					out.write(",\"core\":").writeUInt(c.des.front()->core()->id);
+				out.put('}');
+			}
+			out.put('}');
 			if(extoutp && !hier->root().empty()) {
 				// Unwrap root clusters
 				//,“communities”: {  // Specification of the nodes (final leafs) for the clusters
@@ -214,19 +256,20 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 				//			...
 				//		}, ...
 				//}
-				fputs(",\"communities\":{", stdout);
+				out.write(",\"communities\":{");
 				size_t  j = 0;
 				for(const auto cl: hier->root()) {
 					// Cluster id
-					printf(j++ ? "},\"%u\":{" : "\"%u\":{", cl->id);
+					out.write(j++ ? "},\"" : "\"").writeUInt(cl->id).write("\":{");
 					// Nodes shares
 					ClusterNodes<LinksT>  cns;
 					hier->unwrap(*cl, cns);
 					size_t  i = 0;
 					for(const auto icn: cns)
-						printf(i++ ? ",\"%u\":%G" : "\"%u\":%G", icn.first->id, icn.second);
+						out.write(i++ ? ",\"" : "\"").writeUInt(icn.first->id).write("\":")
+							.writeFloat(icn.second);
 				}
-				fputs("}}", stdout);
+				out.write("}}");
 				if(extoutp >= 2) {
 					//,“levels”: [
 					//	{  // Specification of the clusters on this level including selflink
@@ -236,32 +279,33 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 					//		}, ...
 					//	}, ...
 					//]
-					fputs(",\"levels\":[", stdout);
-					while(hier->traverseNextLevel(outpClsLinksJSON<Cluster<LinksT>>))
-						putchar(',');
-					putchar(']');
+					out.write(",\"levels\":[");
+					while(hier->traverseNextLevel(outpClsLinksJSON<Cluster<LinksT>>, &out))
+						out.put(',');
+					out.put(']');
 				}
 			}
-			printf(",\"nodes\":%lu,\"mod\":%G}", hier->nodes().size()
-				, hier->score().modularity);
+			out.write(",\"nodes\":").writeUInt(hier->nodes().size())
+				.write(",\"mod\":").writeFloat(hier->score().modularity).put('}');
 		} else {
 			// CSV like format
-			printf("# Clusters output format:\n");
-			printf("# <cluster_id1>> [owners: <owner_id1> ...;] [des: <des_id1> ...;] [leafs: <leaf_id1> ...]\n");
+			out.write("# Clusters output format:\n");
+			out.write("# <cluster_id1>> [owners: <owner_id1> ...;] [des: <des_id1> ...;] [leafs: <leaf_id1> ...]\n");
 			// Write all clusters, root are nodes without owner
 			for(const auto& c: hier->clusters()) {
-				printf("%u> %s%s%s%s\n", c.id, (!c.owners.empty()
-					? itemsToStr(c.owners, ' ', true, "owners: ", "; ").c_str()
-						: "")
-					, itemsToStr(c.des, ' ', true, "des: ").c_str()
-					, c.des.front()->descs() ? "" : "; leafs: true"
-					, c.des.front()->core() ? (string("; core: ")
-						+= to_string(c.des.front()->core()->id)).c_str() : ""
-				);
+				out.writeUInt(c.id).write("> ");
+				writeItems(out, c.owners, ' ', true, "owners: ", "; ");
+				writeItems(out, c.des, ' ', true, "des: ");
+				if(!c.des.front()->descs())
+					out.write("; leafs: true");
+				if(c.des.front()->core())
+					out.write("; core: ").writeUInt(c.des.front()->core()->id);
+				out.put('\n');
 			}
-			printf("# Nodes: %lu, clusers: %lu, roots: %lu, mod: %G\n"
-				, hier->nodes().size(), hier->clusters().size(), hier->root().size()
-				, hier->score().modularity);
+			out.write("# Nodes: ").writeUInt(hier->nodes().size())
+				.write(", clusers: ").writeUInt(hier->clusters().size())
+				.write(", roots: ").writeUInt(hier->root().size())
+				.write(", mod: ").writeFloat(hier->score().modularity).put('\n');
 		}
 	}
 
@@ -272,13 +316,17 @@ void Client::processNodes(Nodes<LinksT>& nodes, bool symmetric, bool validate
 //				printf("Node #%2u: %s\n", n.id, linksToStr(n.links).c_str());
 //		}
 	// Here Clusters destructors output will be under DEBUG
-	printf("\n");
+	out.put('\n');
+	out.close();
 }
 
 Client::Client()
 : m_outfmpt('t'), m_extoutp(false), m_validate(true), m_fast(false), m_reorder(false)
-, m_modProfitMarg(-0.999), m_inpfile(), m_nodesNum(0), m_nodesStartId(ID_NONE)
-, m_graphPtr(nullptr)
+, m_resdub(false), m_arcs(false), m_elweights(false), m_threads(1), m_seed(0)
+, m_order(NodesOrder::NONE), m_modProfitMarg(-0.999)
+, m_inpfile()
+, m_inpfmt(), m_outfile()
+, m_higbfile(), m_nodesNum(0), m_nodesStartId(ID_NONE), m_graphPtr(nullptr)
 {}
 
 bool Client::parseArgs(int argc, char *argv[])
@@ -304,6 +352,11 @@ bool Client::parseArgs(int argc, char *argv[])
 			if(opt.length() >= 3)
 				m_extoutp = opt[2] == 'e' ? 1 : 2;
 			break;
+		case 'w':
+			m_outfile = opt.substr(1);
+			if(m_outfile.empty())
+				throw domain_error("Output file name is expected: -" + opt + "\n");
+			break;
 		case 'c':
 			m_validate = false;
 			break;
@@ -312,10 +365,64 @@ bool Client::parseArgs(int argc, char *argv[])
 			break;
 		case 'r':
 			m_reorder = true;
+			// Note: the seed is reported to reproduce the shuffling
+			m_seed = opt.length() >= 2 ? stoul(opt.substr(1)) : time(nullptr);
+			fprintf(stderr, "-Shuffling seed: %u\n", m_seed);
+			break;
+		case 'l':
+			if(opt.length() > 2)
+				throw domain_error("Unexpected option is provided: -" + opt + "\n");
+			switch(opt.length() >= 2 ? opt[1] : 'r') {
+			case 'd':
+				m_order = NodesOrder::DEGREE;
+				break;
+			case 'b':
+				m_order = NodesOrder::BFS;
+				break;
+			case 'r':
+				m_order = NodesOrder::RCM;
+				break;
+			default:
+				throw domain_error("Unexpected option is provided: -" + opt + "\n");
+			}
+			break;
+		case 'd':
+			m_resdub = true;
+			break;
+		case 'a':
+			m_arcs = true;
+			break;
+		case 'e':
+			m_elweights = true;
+			break;
+		case 'i':
+			m_inpfmt = opt.substr(1);
+			inputFormat(m_inpfmt);  // Validate the format
 			break;
 		case 'm':
 			m_modProfitMarg = stof(opt.substr(1));
 			break;
+		case 'b':
+			m_higbfile = opt.substr(1);
+			if(m_higbfile.empty()) {
+				if(m_inpfile == "-")
+					throw domain_error("The .higb file name is expected for stdin input: -" + opt + "\n");
+				// Replace extension of the input file omitting the compression one
+				m_higbfile = m_inpfile;
+				if(m_higbfile.size() > 3 && !m_higbfile.compare(m_higbfile.size() - 3, 3, ".gz"))
+					m_higbfile.resize(m_higbfile.size() - 3);
+				auto  iext = m_higbfile.rfind('.');
+				if(iext != string::npos && m_higbfile.find('/', iext) == string::npos)
+					m_higbfile.resize(iext);
+				m_higbfile += ".higb";
+			}
+			break;
+		case 'j':
+			m_threads = opt.length() >= 2 ? stoul(opt.substr(1))
+				: hardwareThreads();
+			if(!m_threads)
+				m_threads = 1;
+			break;
 		default:
 			throw invalid_argument("Unexpected option is provided: -" + opt + "\n");
 		}
@@ -325,19 +432,49 @@ bool Client::parseArgs(int argc, char *argv[])
 
 void Client::usage(const char filename[]) const
 {
-	printf("Usage: %s [-o{t,c,j}] [-f] [-r] [-m<float>] <adjacency_matrix.hig>\n"
+	printf("Usage: %s [-o{t,c,j}] [-w<output>] [-f] [-r[<seed>]] [-l{d,b,r}] [-i<format>] [-d] [-a] [-e] [-m<float>] [-j[<threads>]] [-b[<graph.higb>]]"
+		" <adjacency_matrix.{hig,higb,net,el,graph,mtx}>\n"
+		"  <adjacency_matrix>  - input file, \"-\" means stdin. Stdin, pipes and"
+		" gzip compressed input should be in the .hig format\n"
 		"  -o  - output data format. Default: t\n"
 		"    t  - text like representation for logs\n"
 		"    c  - CSV like representation for parcing\n"
 		"    j  - JSON represenation\n"
 		"    je  - extended JSON represenation (j + unwrap root clusters to nodes)\n"
 		"    jd  - detaile JSON represenation (je + show inter-cluster links)\n"
+		"  -w<output>  - output the hierarchy into the specified file. Default: stdout\n"
 		"  -c  - clean links, skip links validation\n"
 		"  -f  - fast quazy-mutual clustering (faster). Default: strictly-mutual (better)\n"
-		"  -r  - rand reorder (shuffle) nodes and links on nodes construction\n"
+		"  -r[<seed>]  - rand reorder (shuffle) nodes and links on the graph"
+		" construction, reproducible for the seed. Default seed: current time\n"
+		"  -l{d,b,r}  - reorder nodes to improve locality of the links before"
+		" the clustering, ids of the nodes are retained. Default: r\n"
+		"    d  - descending degrees (hubs first)\n"
+		"    b  - breadth-first traversal\n"
+		"    r  - reverse Cuthill-McKee\n"
+		"  -i<format>  - input format, detected by the content and extension"
+		" (.graph is METIS, .el is edge list) by default, unrecognized input fails\n"
+		"    hig  - HiReCS input graph\n"
+		"    higb  - binary HiReCS graph\n"
+		"    net  - Pajek\n"
+		"    el  - edge list (SNAP): <src_id> <dst_id> [<weight>] per line,"
+		" the weight is loaded only with -e\n"
+		"    graph  - METIS adjacency lists\n"
+		"    mtx  - Matrix Market coordinate matrix\n"
+		"  -d  - resolve duplicated links of the Pajek, edge list and mtx input"
+		" (the last weight is used)\n"
+		"  -a  - links of the edge list are arcs (directed). Default: edges\n"
+		"  -e  - the third column of the edge list is the link weight."
+		" Default: the remained columns (timestamps, etc.) are omitted\n"
 		"  -m<float>  - modularity profit margin for early exit"
 		", float E [-1, 1]. Default: -0.999, but on practice >~= 0\n"
 		"    -1  - skip stderr tracing after each iteration. Recommended: 1E-6 or 0\n"
+		"  -j[<threads>]  - number of threads for the input links parsing"
+		" and processing (validation, reordering)."
+		" Default: 1, -j means the number of hardware threads\n"
+		"  -b[<graph.higb>]  - convert the input graph into the binary .higb format"
+		" without clustering. Default output: <adjacency_matrix>.higb\n"
+		"    .higb input is loaded without parsing, -r is not applied to it\n"
 		, filename);
 }
 
@@ -348,8 +485,13 @@ void Client::processGraph()
 		throw domain_error("Graph should be existed\n");
 	auto graph = reinterpret_cast<Graph<WEIGHTED>*>(m_graphPtr);
 
-	processNodes(graph->finalize(), !graph->directed(), m_validate
-		, m_fast, m_modProfitMarg, m_outfmpt, m_extoutp);
+	if(m_higbfile.empty())
+		processNodes(graph->finalize(m_threads), !graph->directed(), m_validate
+			, m_fast, m_modProfitMarg, m_outfmpt, m_extoutp, m_threads, m_outfile, m_order);
+	else {
+		saveHigb<WEIGHTED>(m_higbfile, graph->finalize(m_threads), graph->directed());
+		fprintf(stderr, "-Graph is converted to: %s\n", m_higbfile.c_str());
+	}
 
 	// Finalize processing
 	delete graph;
@@ -357,179 +499,408 @@ void Client::processGraph()
 }
 
 template<bool WEIGHTED>
-void Client::parseLinks(string& line, bool directed)
+void Client::processHigb(const MappedFile& infile)
+{
+	typename Graph<WEIGHTED>::NodesT  nodes;
+	loadHigb<WEIGHTED>(infile, nodes);
+	processNodes(nodes, !higbHeader(infile).directed, m_validate
+		, m_fast, m_modProfitMarg, m_outfmpt, m_extoutp, m_threads, m_outfile, m_order);
+}
+
+template<bool WEIGHTED>
+void Client::processFormatted(const MappedFile& infile, InputFormat fmt)
+{
+	auto makeGraph = [this](Id nodesNum, Id startId) -> Graph<WEIGHTED>& {
+		m_nodesNum = nodesNum;
+		m_nodesStartId = startId;
+		return graph<WEIGHTED>();
+	};
+	switch(fmt) {
+	case InputFormat::PAJEK:
+		loadPajek<WEIGHTED>(infile, m_resdub, makeGraph);
+		break;
+	case InputFormat::EDGELIST:
+		loadEdgeList<WEIGHTED>(infile, m_arcs, m_elweights, m_resdub, makeGraph, m_threads);
+		break;
+	case InputFormat::METIS:
+		loadMetis<WEIGHTED>(infile, makeGraph);
+		break;
+	case InputFormat::MTX:
+		loadMtx<WEIGHTED>(infile, m_resdub, makeGraph, m_threads);
+		break;
+	default:
+		throw domain_error("processFormatted(), unexpected input format\n");
+	}
+	processGraph<WEIGHTED>();
+}
+
+template<bool WEIGHTED>
+Graph<WEIGHTED>& Client::graph()
 {
 	using GraphT = Graph<WEIGHTED>;
 
 	// Grate Graph if required
 	if(!m_graphPtr) {
-		m_graphPtr = new GraphT(m_nodesNum, m_reorder);
+		m_graphPtr = new GraphT(m_nodesNum, m_reorder, m_seed);
 		if(m_nodesStartId != ID_NONE)
 			reinterpret_cast<GraphT*>(m_graphPtr)
 				->addNodes(m_nodesStartId, m_nodesStartId + m_nodesNum);
 	}
+	return *reinterpret_cast<GraphT*>(m_graphPtr);
+}
+
+template<bool WEIGHTED>
+bool Client::scanLinks(const char* line, const char* lineEnd, Id& nid
+	, typename Graph<WEIGHTED>::InpLinksT& links)
+{
+	using Link = typename Graph<WEIGHTED>::InpLinkT;
+	using Weight = typename Link::Weight;
+	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;  // 2 ("0", ".") + 6 digits for float = 8
 
-	// Parse links
-	constexpr char  spaces[] = " \t";
+	// Parse links in place without any intermediate strings
 	// Fetch node id
-	size_t  pos;
-	Id  nid = stoul(line, &pos);
+	// Note: error positions are relative to the line begin
+	const char*  pos = skipSpaces(line, lineEnd);
+	if(!scanId(pos, lineEnd, nid))
+		throw invalidValueFormat(line, lineEnd, pos, SYM_DIGITS_MAX);
 
 	// Fetch links
-	pos = line.find_first_not_of(spaces, line.find('>', pos));
-	if(pos == string::npos)
-		return;
+	pos = static_cast<const char*>(memchr(pos, '>', lineEnd - pos));
+	if(!pos)
+		return false;
 	++pos;
-	const auto  lineLen = line.length();
-	typename GraphT::InpLinksT  links;
-	using Link = typename GraphT::InpLinkT;
-	using Weight = typename Link::Weight;
-	constexpr unsigned char  SYM_DIGITS_MAX = numeric_limits<Weight>::digits10 + 2;  // 2 ("0", ".") + 6 digits for float = 8
 
-	while(pos < lineLen) {
-		pos = line.find_first_not_of(spaces, pos);
+	while((pos = skipSpaces(pos, lineEnd)) != lineEnd && *pos != '#') {
 		// Fetch dest id
-		size_t  offs;
-		Id  did = stoul(line.substr(pos, SYM_DIGITS_MAX), &offs);
-		pos += offs;
+		Id  did;
+		if(!scanId(pos, lineEnd, did))
+			throw invalidValueFormat(line, lineEnd, pos, SYM_DIGITS_MAX);
 		// Next is : or space
 		// Fetch link weight
 		Weight  weight = 0;
 		bool  weightAssigned = false;
-		if(WEIGHTED && pos < lineLen && line[pos] == ':') {
-			weight = stof(line.substr(++pos, SYM_DIGITS_MAX), &offs);
-			weightAssigned = true;
-			pos += offs;
+		if(pos != lineEnd && *pos == ':') {
+			++pos;
+			if(WEIGHTED) {
+				if(!scanFloat(pos, lineEnd, weight))
+					throw invalidValueFormat(line, lineEnd, pos, SYM_DIGITS_MAX);
+				weightAssigned = true;
+			} else while(pos != lineEnd && !isSpace(*pos))
+				++pos;  // Weights are skipped for the unweighted graph
 		}
-		offs = line.find_first_of(spaces, pos);
-		if(offs != pos && offs != string::npos && (WEIGHTED || line[pos] != ':')) {
-			constexpr size_t  ctxSize = SYM_DIGITS_MAX;
-			size_t  pbeg = 0;
-			if(pos > ctxSize)
-				pbeg = pos - ctxSize;
-			size_t  pend = pos + ctxSize + 1;
-			if(pend > line.size())
-				pend = line.size();
-
-			throw domain_error(to_string(pos).insert(0
-				, "Invalid value format in pos: ").append(", context(+/-PRECISION_DIG symbols): ")
-				+= line.substr(pbeg, pend - pbeg) += '\n');
-		}
-		pos = offs;
+		if(pos != lineEnd && !isSpace(*pos) && *pos != '#')
+			throw invalidValueFormat(line, lineEnd, pos, SYM_DIGITS_MAX);
 		if(weightAssigned)
 			Operations<!Link::IS_WEIGHTED>::addLink(links, did, weight);
 		else Operations<true>::addLink<Weight>(links, did);
-		if(pos == string::npos)
-			pos = lineLen;
 	}
+	return true;
+}
 
-	// Store links in the Graph
-	if(!links.empty()) {
-		GraphT  &graph = *reinterpret_cast<GraphT*>(m_graphPtr);
-		if(m_nodesStartId != ID_NONE) {
-			if(directed)
-				graph.template addNodeLinks<true>(nid, links);
-			else graph.template addNodeLinks<false>(nid, links);
-		} else if(directed)
-			graph.template addNodeAndLinks<true>(nid, links);
-		else graph.template addNodeAndLinks<false>(nid, links);
-	}
+template<bool WEIGHTED>
+void Client::storeLinks(Id nid, const typename Graph<WEIGHTED>::InpLinksT& links
+	, bool directed)
+{
+	if(links.empty())
+		return;
+
+	auto&  graph = this->graph<WEIGHTED>();
+	if(m_nodesStartId != ID_NONE) {
+		if(directed)
+			graph.template addNodeLinks<true>(nid, links);
+		else graph.template addNodeLinks<false>(nid, links);
+	} else if(directed)
+		graph.template addNodeAndLinks<true>(nid, links);
+	else graph.template addNodeAndLinks<false>(nid, links);
 }
 
-void Client::process()
+template<bool WEIGHTED>
+void Client::parseLinks(const char* line, const char* lineEnd, bool directed
+	, typename Graph<WEIGHTED>::InpLinksT& links)
 {
-	// Default Graph params
-	bool  weighted = true;
+	graph<WEIGHTED>();
+	links.clear();
+	Id  nid;
+	if(scanLinks<WEIGHTED>(line, lineEnd, nid, links))
+		storeLinks<WEIGHTED>(nid, links, directed);
+}
 
-	assert(m_graphPtr == nullptr && "m_graphPtr should be empty on start\n");
-	m_nodesNum = 0;
-	m_nodesStartId = ID_NONE;
-	m_graphPtr = nullptr;
+template<bool WEIGHTED>
+const char* Client::parseLinksSection(const char* body, const char* end, bool directed
+	, bool reserve)
+{
+	graph<WEIGHTED>();
 
-	constexpr char  spaces[] = " \t";
-	string  line;
-	ifstream  infile;
-	// Set exceptions to any file IO operations
-	infile.exceptions(ifstream::badbit);  // | ifstream::failbit
-	infile.open(m_inpfile);
-	FileSection sect = FileSection::NONE;
-	while(getline(infile, line)) {
+	// Identify the section end: the first header line or end of the text
+	const char*  sectEnd = body;
+	while(sectEnd != end) {
+		const char*  pos = skipSpaces(sectEnd, end);
+		if(pos != end && *pos == '/')
+			break;
+		pos = static_cast<const char*>(memchr(pos, '\n', end - pos));
+		sectEnd = pos ? pos + 1 : end;
+	}
+
+	// Split the section into chunks by lines
+	// Note: the chunks are more numerous than the threads to balance the load
+	constexpr unsigned  THREAD_CHUNKS = 4;
+	using LinksChunkT = LinksChunk<WEIGHTED>;
+	vector<LinksChunkT>  chunks(m_threads * THREAD_CHUNKS);
+	const size_t  chunkSize = (sectEnd - body) / chunks.size() + 1;
+	const char*  pos = body;
+	for(auto& chunk: chunks) {
+		chunk.beg = pos;
+		if(sectEnd - pos > ptrdiff_t(chunkSize)) {
+			pos = static_cast<const char*>(memchr(pos + chunkSize, '\n'
+				, sectEnd - pos - chunkSize));
+			pos = pos ? pos + 1 : sectEnd;
+		} else pos = sectEnd;
+		chunk.end = pos;
+	}
+
+	// Fetch links of the next significant line of the text extending the links
+	// Note: lines without links are skipped
+	auto nextLinks = [](const char*& line, const char* end, Id& nid
+		, typename LinksChunkT::InpLinksT& links) -> bool {
+		while(line != end) {
+			const char*  lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+			if(!lineEnd)
+				lineEnd = end;
+			const char*  ln = line;
+			const char*  pos = skipSpaces(line, lineEnd);
+			line = lineEnd != end ? lineEnd + 1 : end;
+			// Skip empty lines and comments
+			if(pos == lineEnd || *pos == '#')
+				continue;
+			const size_t  lnum = links.size();
+			if(scanLinks<WEIGHTED>(ln, lineEnd, nid, links) && links.size() != lnum)
+				return true;
+		}
+		return false;
+	};
+
+	if(reserve) {
+		// Count links of the nodes considering the back links of edges by the
+		// concurrent pass over the chunks into the shared counters
+		// Note: self links form the self weight, links to the out of range nodes
+		// are omitted to be reported on the storing
+		vector<atomic<Id>>  degrees(m_nodesNum);
+		parallelRanges(chunks.size(), [&](size_t beg, size_t end) {
+			typename LinksChunkT::InpLinksT  links;
+			Id  nid;
+			for(auto ic = beg; ic != end; ++ic)
+				for(const char* line = chunks[ic].beg; nextLinks(line, chunks[ic].end, nid, links);) {
+					const Id  isrc = nid - m_nodesStartId;
+					for(const auto& ln: links) {
+						const Id  idst = ln.id - m_nodesStartId;
+						if(idst == isrc || isrc >= m_nodesNum || idst >= m_nodesNum)
+							continue;
+						degrees[isrc].fetch_add(1, std::memory_order_relaxed);
+						if(!directed)
+							degrees[idst].fetch_add(1, std::memory_order_relaxed);
+					}
+					links.clear();
+				}
+		}, m_threads, 1);
+		auto&  graph = this->graph<WEIGHTED>();
+		for(Id i = 0; i < m_nodesNum; ++i)
+			if(degrees[i])
+				graph.reserveLinks(m_nodesStartId + i, degrees[i]);
+		vector<atomic<Id>>().swap(degrees);
+
+		// Parse links of each line directly into the reserved nodes
+		// Note: the Graph is extended by a single thread, since the back links
+		// of edges extend other nodes
+		typename LinksChunkT::InpLinksT  links;
+		Id  nid;
+		for(const char* line = body; nextLinks(line, sectEnd, nid, links);) {
+			storeLinks<WEIGHTED>(nid, links, directed);
+			links.clear();
+		}
+		return sectEnd;
+	}
+
+	// Parse the chunks concurrently
+	parallelRanges(chunks.size(), [&chunks, &nextLinks](size_t beg, size_t end) {
+		Id  nid;
+		for(auto ic = beg; ic != end; ++ic) {
+			auto&  chunk = chunks[ic];
+			for(const char* line = chunk.beg; nextLinks(line, chunk.end, nid, chunk.links);)
+				chunk.nodes.emplace_back(nid, chunk.links.size());
+		}
+	}, m_threads, 1);
+
+	// Merge the chunks into the Graph in the order of the input
+	typename LinksChunkT::InpLinksT  links;
+	for(auto& chunk: chunks) {
+		size_t  lbeg = 0;
+		for(const auto& nd: chunk.nodes) {
+			links.assign(chunk.links.begin() + lbeg, chunk.links.begin() + nd.second);
+			lbeg = nd.second;
+			storeLinks<WEIGHTED>(nd.first, links, directed);
+		}
+		// Release the chunk memory as soon as possible
+		chunk.nodes = vector<pair<Id, size_t>>();
+		chunk.links = typename LinksChunkT::InpLinksT();
+	}
+
+	return sectEnd;
+}
+
+void Client::parseSection(string& line, FileSection& sect, bool& weighted)
+{
+	constexpr char  spaces[] = " \t\r";
+	// Extract section name and convert to lowercase
+	size_t  pos = 0;
+	auto pose = line.find_first_of(spaces, ++pos);
+	string  title = line.substr(pos, pose - pos);
+	if(title.empty())
+		throw domain_error("Invalid (empty) section header\n");
+	for(size_t i = 0; i != title.length(); ++i)
+		title[i] = tolower(title[i]);
+	// Remove tail comment if exists
+	pos = line.find("#", pose);
+	if(pos != string::npos)
+		line.resize(pos);
+
+	// Define current section
+	if(!title.compare("graph")) {
+		if(sect != FileSection::NONE)
+			throw domain_error(
+				"Unexpected section: Graph section must be first one\n");
+
+		sect = FileSection::GRAPH;
+		// Load weighted attribute
+		if(pose != string::npos) {
+			// Process attrib weighted
+			title = "weighted:";
+			pos = line.find(title, pose + 1);
+			if(pos != string::npos) {
+				// Fetch value
+				pos = line.find_first_not_of(spaces, pos + title.length());
+				weighted = stoi(line.substr(pos
+					, line.find_first_of(spaces, pos + 1)));
+			}
+		}
+	} else if(!title.compare("nodes")) {
+		if(sect != FileSection::NONE && sect != FileSection::GRAPH)
+			throw domain_error(
+				"Unexpected section: Nodes section must be first one"
+				" or after the Graph section\n");
+
+		sect = FileSection::NODES;
+		// Load Nodes attributes
+		if(pose != string::npos) {
+			// nodesNum
+			pos = line.find_first_not_of(spaces, pose + 1);
+			if(pos != string::npos) {
+				m_nodesNum = stoul(line.substr(pos
+					, pose = line.find_first_of(spaces, pos + 1)));
+				// nodesStartId
+				if(pose != string::npos) {
+					pos = line.find_first_not_of(spaces, pose + 1);
+					if(pos != string::npos)
+						m_nodesStartId = stoul(line.substr(pos
+							, line.find_first_of(spaces, pos + 1)));
+				}
+			}
+		}
+	} else if(!title.compare("edges"))
+		sect = FileSection::EDGES;
+	else if(!title.compare("arcs"))
+		sect = FileSection::ARCS;
+	else throw out_of_range(
+		title.insert(0, "Unknown section is used: ") += '\n');
+}
+
+void Client::parseHig(const char* data, const char* end, FileSection& sect, bool& weighted
+	, bool whole)
+{
+	// Note: links buffers are reused between the lines to avoid reallocations
+	Graph<true>::InpLinksT  wlinks;
+	Graph<false>::InpLinksT  links;
+	for(const char* line = data; line != end;) {
+		const char*  lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+		if(!lineEnd)
+			lineEnd = end;
+		const char*  ln = line;
 		// Skip leading spaces
-		auto pos = line.find_first_not_of(spaces);
+		const char*  pos = skipSpaces(line, lineEnd);
+		line = lineEnd != end ? lineEnd + 1 : end;
 		// Skip empty lines and comments
-		if(pos == string::npos || line[pos] == '#')
+		if(pos == lineEnd || *pos == '#')
 			continue;
 
 		// Define file section and parse it
-		if(line[pos] != '/') {
+		if(*pos != '/') {
 			if(sect != FileSection::EDGES && sect != FileSection::ARCS)
 				continue;
 
+			// Note: links of the whole section with the known nodes range are
+			// counted first to allocate links of the nodes once by the exact size
+			const bool  reserve = whole && m_nodesStartId != ID_NONE;
+			if(m_threads > 1 || reserve) {
+				// Parse the whole section concurrently from the current line
+				if(weighted)
+					line = parseLinksSection<true>(ln, end, sect == FileSection::ARCS, reserve);
+				else line = parseLinksSection<false>(ln, end, sect == FileSection::ARCS, reserve);
+				continue;
+			}
 			if(weighted)
-				parseLinks<true>(line, sect == FileSection::ARCS);
-			else parseLinks<false>(line, sect == FileSection::ARCS);
+				parseLinks<true>(ln, lineEnd, sect == FileSection::ARCS, wlinks);
+			else parseLinks<false>(ln, lineEnd, sect == FileSection::ARCS, links);
 		} else {
-			// Extract section name and convert to lowercase
-			auto pose = line.find_first_of(spaces, ++pos);
-			string  title = line.substr(pos, pose - pos);
-			if(title.empty())
-				throw domain_error("Invalid (empty) section header\n");
-			for(size_t i = 0; i != title.length(); ++i)
-				title[i] = tolower(title[i]);
-			// Remove tail comment if exists
-			pos = line.find("#", pose);
-			if(pos != string::npos)
-				line.resize(pos);
-
-			// Define current section
-			if(!title.compare("graph")) {
-				if(sect != FileSection::NONE)
-					throw domain_error(
-						"Unexpected section: Graph section must be first one\n");
-
-				sect = FileSection::GRAPH;
-				// Load weighted attribute
-				if(pose != string::npos) {
-					// Process attrib weighted
-					title = "weighted:";
-					pos = line.find(title, pose + 1);
-					if(pos != string::npos) {
-						// Fetch value
-						pos = line.find_first_not_of(spaces, pos + title.length());
-						weighted = stoi(line.substr(pos
-							, line.find_first_of(spaces, pos + 1)));
-					}
-				}
-			} else if(!title.compare("nodes")) {
-				if(sect != FileSection::NONE && sect != FileSection::GRAPH)
-					throw domain_error(
-						"Unexpected section: Nodes section must be first one"
-						" or after the Graph section\n");
-
-				sect = FileSection::NODES;
-				// Load Nodes attributes
-				if(pose != string::npos) {
-					// nodesNum
-					pos = line.find_first_not_of(spaces, pose + 1);
-					if(pos != string::npos) {
-						m_nodesNum = stoul(line.substr(pos
-							, pose = line.find_first_of(spaces, pos + 1)));
-						// nodesStartId
-						if(pose != string::npos) {
-							pos = line.find_first_not_of(spaces, pose + 1);
-							if(pos != string::npos)
-								m_nodesStartId = stoul(line.substr(pos
-									, line.find_first_of(spaces, pos + 1)));
-						}
-					}
-				}
-			} else if(!title.compare("edges"))
-				sect = FileSection::EDGES;
-			else if(!title.compare("arcs"))
-				sect = FileSection::ARCS;
-			else throw out_of_range(
-				title.insert(0, "Unknown section is used: ") += '\n');
+			// Note: headers are rare, so they are processed as strings
+			string  header(pos, lineEnd);
+			parseSection(header, sect, weighted);
+		}
+	}
+}
+
+void Client::process()
+{
+	// Default Graph params
+	bool  weighted = true;
+	FileSection sect = FileSection::NONE;
+
+	assert(m_graphPtr == nullptr && "m_graphPtr should be empty on start\n");
+	m_nodesNum = 0;
+	m_nodesStartId = ID_NONE;
+	m_graphPtr = nullptr;
+
+	// Note: the file is mapped and parsed in place, which avoids
+	// intermediate copying and strings allocation for each line
+	// Note: pipes (including the process substitution) can't be mapped
+	const bool  streamed = m_inpfile == "-" || !regularFile(m_inpfile);
+	MappedFile  infile;
+	if(!streamed)
+		infile.open(m_inpfile);
+	if(streamed || gzipMatches(infile.data(), infile.size())) {
+		// Stdin, pipes and compressed files are read by blocks in the reader thread
+		if(!m_inpfmt.empty() && inputFormat(m_inpfmt) != InputFormat::HIG)
+			throw domain_error("Only the .hig format is supported for stdin, pipes and gzip input\n");
+		infile.close();
+		TextStream  instream(m_inpfile);
+		for(const char *data, *end; instream.next(data, end);)
+			parseHig(data, end, sect, weighted);
+	} else {
+		const InputFormat  fmt = m_inpfmt.empty() ? inputFormat(infile, m_inpfile)
+			: inputFormat(m_inpfmt);
+		if(fmt == InputFormat::HIGB) {
+			if(!m_higbfile.empty())
+				throw domain_error("The input graph is already in the .higb format\n");
+			if(higbHeader(infile).weighted)
+				processHigb<true>(infile);
+			else processHigb<false>(infile);
+			return;
+		}
+		if(fmt != InputFormat::HIG) {
+			// Note: links of the external formats are weighted, the weight is 1 by default
+			processFormatted<true>(infile, fmt);
+			assert(m_graphPtr == nullptr  && "Graph must be released after processing\n");
+			return;
 		}
+		parseHig(infile.data(), infile.end(), sect, weighted, true);
 	}
 
 	// Perfom clustering
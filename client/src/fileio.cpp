@@ -0,0 +1,372 @@
+//! \brief Files access for the High Resolution Hierarchical Clustering with Stable State (HiReCS) client
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+#include <cerrno>
+#include <cstddef>  // ptrdiff_t
+#include <cmath>  // pow, floor, fabs, signbit
+#include <system_error>
+#include <fcntl.h>  // open
+#include <unistd.h>  // close
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat, stat
+#include <cstring>  // memrchr
+#include "fileio.h"
+
+using std::system_error;
+using std::system_category;
+using std::pow;
+using std::floor;
+using std::fabs;
+using std::to_string;
+using std::unique_lock;
+using std::lock_guard;
+
+
+// MappedFile implementation --------------------------------------------------
+MappedFile::MappedFile(const string& filename)
+: m_data(nullptr), m_size(0)
+{
+	open(filename);
+}
+
+MappedFile::MappedFile(MappedFile&& mf)
+: m_data(mf.m_data), m_size(mf.m_size)
+{
+	mf.m_data = nullptr;
+	mf.m_size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& mf)
+{
+	if(this != &mf) {
+		close();
+		m_data = mf.m_data;
+		m_size = mf.m_size;
+		mf.m_data = nullptr;
+		mf.m_size = 0;
+	}
+	return *this;
+}
+
+void MappedFile::open(const string& filename)
+{
+	close();
+
+	int  fd = ::open(filename.c_str(), O_RDONLY);
+	if(fd == -1)
+		throw system_error(errno, system_category()
+			, "The file can't be opened: " + filename);
+	struct stat  st;
+	if(fstat(fd, &st) == -1) {
+		int  err = errno;
+		::close(fd);
+		throw system_error(err, system_category()
+			, "The file attributes can't be fetched: " + filename);
+	}
+	// Note: pipes have zero size, so they would be silently taken as empty
+	if(!S_ISREG(st.st_mode)) {
+		::close(fd);
+		throw domain_error("Only regular files can be mapped: " + filename);
+	}
+	// Note: empty files can't be mapped and do not require it
+	if(st.st_size) {
+		void*  data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			int  err = errno;
+			::close(fd);
+			throw system_error(err, system_category()
+				, "The file can't be mapped: " + filename);
+		}
+		// The content is parsed sequentially, which allows aggressive read ahead
+		madvise(data, st.st_size, MADV_SEQUENTIAL);
+		m_data = static_cast<const char*>(data);
+		m_size = st.st_size;
+	}
+	// Note: the mapping remains valid after the descriptor is closed
+	::close(fd);
+}
+
+void MappedFile::close()
+{
+	if(m_data) {
+		munmap(const_cast<char*>(m_data), m_size);
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
+
+bool regularFile(const string& filename)
+{
+	struct stat  st;
+	if(stat(filename.c_str(), &st) == -1)
+		throw system_error(errno, system_category()
+			, "The file attributes can't be fetched: " + filename);
+	return S_ISREG(st.st_mode);
+}
+
+// TextStream implementation --------------------------------------------------
+TextStream::TextStream(const string& filename)
+: m_file(nullptr), m_ready(), m_free(), m_block(), m_eof(false), m_stop(false)
+, m_error(), m_mutex(), m_cond(), m_reader()
+{
+	if(filename == "-") {
+		// Note: the descriptor is duplicated to not close stdin with the stream
+		int  fd = dup(STDIN_FILENO);
+		if(fd == -1 || !(m_file = gzdopen(fd, "rb"))) {
+			int  err = errno;
+			if(fd != -1)
+				::close(fd);
+			throw system_error(err, system_category(), "The stdin can't be opened");
+		}
+	} else if(!(m_file = gzopen(filename.c_str(), "rb")))
+		throw system_error(errno, system_category()
+			, "The file can't be opened: " + filename);
+	gzbuffer(m_file, 1 << 20);
+	m_reader = thread(&TextStream::read, this);
+}
+
+TextStream::~TextStream()
+{
+	{
+		lock_guard<mutex>  lock(m_mutex);
+		m_stop = true;
+	}
+	m_cond.notify_all();
+	m_reader.join();
+	gzclose(m_file);
+}
+
+bool TextStream::next(const char*& data, const char*& end)
+{
+	unique_lock<mutex>  lock(m_mutex);
+	if(!m_block.empty()) {
+		m_free.push_back(std::move(m_block));
+		m_block = vector<char>();
+	}
+	m_cond.notify_all();
+	m_cond.wait(lock, [this] { return !m_ready.empty() || m_eof; });
+	if(m_error)
+		std::rethrow_exception(m_error);
+	if(m_ready.empty())
+		return false;
+	m_block = std::move(m_ready.front());
+	m_ready.pop_front();
+	m_cond.notify_all();
+	data = m_block.data();
+	end = data + m_block.size();
+	return true;
+}
+
+void TextStream::read()
+{
+	try {
+		vector<char>  tail;  // Incomplete last line of the previous block
+		for(bool eof = false; !eof;) {
+			vector<char>  block;
+			{
+				unique_lock<mutex>  lock(m_mutex);
+				m_cond.wait(lock, [this] { return m_stop || m_ready.size() < READY_MAX; });
+				if(m_stop)
+					return;
+				if(!m_free.empty()) {
+					block = std::move(m_free.back());
+					m_free.pop_back();
+				}
+			}
+			block.assign(tail.begin(), tail.end());
+			const size_t  size = block.size();
+			block.resize(size + BLOCK_SIZE);
+			int  num = gzread(m_file, block.data() + size, BLOCK_SIZE);
+			if(num < 0) {
+				int  err;
+				const char*  msg = gzerror(m_file, &err);
+				throw domain_error(string("The input stream can't be read: ") += msg);
+			}
+			block.resize(size + num);
+			eof = !num;
+			// Cut the incomplete last line to be completed in the next block
+			tail.clear();
+			if(!eof) {
+				const char*  pos = static_cast<const char*>(memrchr(block.data(), '\n', block.size()));
+				const size_t  lnend = pos ? pos - block.data() + 1 : 0;
+				tail.assign(block.begin() + lnend, block.end());
+				block.resize(lnend);
+			}
+			lock_guard<mutex>  lock(m_mutex);
+			if(!block.empty())
+				m_ready.push_back(std::move(block));
+			m_eof = eof;
+			m_cond.notify_all();
+		}
+	} catch(...) {
+		lock_guard<mutex>  lock(m_mutex);
+		m_error = std::current_exception();
+		m_eof = true;
+		m_cond.notify_all();
+	}
+}
+
+// In-place scanning of the text values ---------------------------------------
+bool scanFloat(const char*& pos, const char* end, float& val)
+{
+	// Exactly representable powers of 10
+	constexpr double  pows10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8
+		, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20
+		, 1e21, 1e22};
+	constexpr int  POWS10_MAX = sizeof pows10 / sizeof *pows10 - 1;
+	// Number of significant digits that fits uint64_t
+	constexpr unsigned  DIGITS_MAX = 19;
+
+	const char*  cur = pos;
+	bool  neg = false;
+	if(cur != end && (*cur == '-' || *cur == '+'))
+		neg = *cur++ == '-';
+	// Mantissa
+	uint64_t  mant = 0;
+	unsigned  digs = 0;  // Number of the significant digits in the mantissa
+	int  exp = 0;  // Decimal exponent
+	const char*  mbeg = cur;
+	for(; cur != end && unsigned(*cur - '0') <= 9; ++cur) {
+		if(digs < DIGITS_MAX) {
+			mant = mant * 10 + (*cur - '0');
+			digs += mant != 0;
+		} else ++exp;
+	}
+	bool  valid = cur != mbeg;
+	if(cur != end && *cur == '.') {
+		mbeg = ++cur;
+		for(; cur != end && unsigned(*cur - '0') <= 9; ++cur)
+			if(digs < DIGITS_MAX) {
+				mant = mant * 10 + (*cur - '0');
+				digs += mant != 0;
+				--exp;
+			}
+		valid |= cur != mbeg;
+	}
+	if(!valid)
+		return false;
+	// Exponent
+	if(cur != end && (*cur == 'e' || *cur == 'E')) {
+		const char*  ecur = cur + 1;
+		bool  eneg = false;
+		if(ecur != end && (*ecur == '-' || *ecur == '+'))
+			eneg = *ecur++ == '-';
+		int  eval = 0;
+		const char*  ebeg = ecur;
+		for(; ecur != end && unsigned(*ecur - '0') <= 9; ++ecur)
+			if(eval < 10000)
+				eval = eval * 10 + (*ecur - '0');
+		// Note: "1e" is interpreted as "1" followed by the "e" symbol like in strtof
+		if(ecur != ebeg) {
+			exp += eneg ? -eval : eval;
+			cur = ecur;
+		}
+	}
+
+	double  res = mant;
+	if(mant && exp) {
+		if(exp > 0)
+			res *= exp <= POWS10_MAX ? pows10[exp] : pow(10., exp);
+		else res /= -exp <= POWS10_MAX ? pows10[-exp] : pow(10., -exp);
+	}
+	val = neg ? -res : res;
+	pos = cur;
+	return true;
+}
+
+// In-place scanning of the text values ---------------------------------------
+domain_error invalidValueFormat(const char* line, const char* lineEnd
+	, const char* pos, size_t ctxSize)
+{
+	const char*  pbeg = pos - line > ptrdiff_t(ctxSize) ? pos - ctxSize : line;
+	const char*  pend = lineEnd - pos > ptrdiff_t(ctxSize + 1) ? pos + ctxSize + 1 : lineEnd;
+
+	return domain_error(to_string(pos - line).insert(0
+		, "Invalid value format in pos: ").append(", context(+/-PRECISION_DIG symbols): ")
+		.append(pbeg, pend) += '\n');
+}
+
+// OutWriter implementation ---------------------------------------------------
+OutWriter::OutWriter(const string& filename)
+: m_file(stdout), m_owner(false), m_buf(BUFFER_SIZE), m_size(0)
+{
+	if(!filename.empty()) {
+		m_file = fopen(filename.c_str(), "w");
+		if(!m_file)
+			throw system_error(errno, system_category()
+				, "The file can't be created: " + filename);
+		m_owner = true;
+	}
+}
+
+OutWriter::~OutWriter()
+{
+	try {
+		close();
+	} catch(...) {}
+}
+
+void OutWriter::flush()
+{
+	if(m_size && m_file && fwrite(m_buf.data(), 1, m_size, m_file) != m_size) {
+		m_size = 0;
+		throw system_error(errno, system_category(), "The output can't be written");
+	}
+	m_size = 0;
+}
+
+void OutWriter::close()
+{
+	if(!m_file)
+		return;
+	FILE*  file = m_file;
+	try {
+		flush();
+	} catch(...) {
+		if(m_owner)
+			fclose(file);
+		m_file = nullptr;
+		throw;
+	}
+	m_file = nullptr;
+	if(m_owner ? fclose(file) : fflush(file))
+		throw system_error(errno, system_category(), "The output can't be completed");
+}
+
+OutWriter& OutWriter::write(const char* text, size_t size)
+{
+	if(m_buf.size() - m_size < size) {
+		flush();
+		// Write the large text directly
+		if(size > m_buf.size()) {
+			if(m_file && fwrite(text, 1, size, m_file) != size)
+				throw system_error(errno, system_category(), "The output can't be written");
+			return *this;
+		}
+	}
+	memcpy(m_buf.data() + m_size, text, size);
+	m_size += size;
+	return *this;
+}
+
+OutWriter& OutWriter::writeFloat(double val)
+{
+	// Note: %G outputs 6 significant digits, so integers below 1E6 are exact
+	if(val == floor(val) && fabs(val) < 1E6 && !(val == 0 && std::signbit(val))) {
+		if(val < 0)
+			put('-');
+		return writeUInt(fabs(val));
+	}
+	// Note: %G takes at most 13 symbols for double
+	constexpr size_t  FLOAT_SIZE_MAX = 16;
+	if(m_buf.size() - m_size < FLOAT_SIZE_MAX)
+		flush();
+	m_size += snprintf(m_buf.data() + m_size, FLOAT_SIZE_MAX, "%G", val);
+	return *this;
+}
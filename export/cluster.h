@@ -13,15 +13,19 @@
 
 #include <unordered_map>
 #include <initializer_list>
+#include <stdexcept>  // out_of_range
 #include "types.h"
 
 namespace hirecs {
 
 using std::unordered_map;
 using std::initializer_list;
+using std::out_of_range;
 
 
 // External Interface for Data Input ------------------------------------------
+using RandSeed = uint32_t;  //!< Seed of the random generator
+
 //! \brief External Input Link
 //!
 //! \tparam WEIGHTED bool  - whether the link is weighted or not
@@ -69,6 +73,92 @@ struct InpLink<false, UNSIGNED> {
 	: id(lid)  {}
 };
 
+//! \brief Mapping of the external node ids into the internal nodes
+//! 	Ids of the solid range are mapped by the dense table indexed by the id
+//! 	offset, the remained (sparse) ids are mapped by the hash map
+//! \note The dense table is formed by the range of nodes added to the empty
+//! 	table and is extended by the subsequent ids while it remains at least half
+//! 	filled. The sparse ids are moved to the dense table when all mapped ids
+//! 	become dense enough (unordered input of the solid range)
+//!
+//! \tparam NodeT  - type of the mapped node
+template<typename NodeT>
+class IdNodes {
+	vector<NodeT*>  m_dense;  // Nodes of the dense ids: [m_base, m_base + m_dense.size())
+	Id  m_base;  // Base id of the dense table
+	Id  m_denseNum;  // Number of the nodes in the dense table
+	unordered_map<Id, NodeT*>  m_sparse;  // Nodes of the remained ids
+	Id  m_sparseMin;  // Min id in the sparse map
+	Id  m_sparseMax;  // Max id in the sparse map
+public:
+	//! Min size of the dense table extension, which is allowed even for the
+	//! sparse ids
+	constexpr static Id  DENSE_MARGIN = 1024;
+
+	IdNodes(): m_dense(), m_base(0), m_denseNum(0), m_sparse()
+	, m_sparseMin(ID_NONE), m_sparseMax(0)  {}
+
+    //! \brief Reserve space for the nodes
+    //!
+    //! \param num size_t  - number of the nodes
+    //! \param idBeg=ID_NONE Id  - start id of the solid range of the nodes
+    //! 	if known, which forms the dense table when the mapping is empty
+    //! \return void
+	void reserve(size_t num, Id idBeg=ID_NONE);
+
+    //! \brief Map the node
+    //!
+    //! \param id Id  - node id
+    //! \param node NodeT*  - mapped node
+    //! \return bool  - whether the node is mapped, false if the id already exists
+	bool emplace(Id id, NodeT* node);
+
+    //! \brief Find the node by id
+    //!
+    //! \param id Id  - node id
+    //! \return NodeT*  - mapped node or nullptr if the id does not exist
+	NodeT* find(Id id) const
+	{
+		const Id  i = id - m_base;  // Note: ids below m_base are wrapped out of the table
+		// Note: the id could be mapped by the sparse map before the dense table
+		// is extended
+		if(i < m_dense.size() && (m_dense[i] || m_sparse.empty()))
+			return m_dense[i];
+		if(m_sparse.empty())
+			return nullptr;
+		auto  isn = m_sparse.find(id);
+		return isn != m_sparse.end() ? isn->second : nullptr;
+	}
+
+    //! \brief Fetch the node by id
+    //! \note out_of_range is thrown if the id does not exist
+    //!
+    //! \param id Id  - node id
+    //! \return NodeT*  - mapped node
+	NodeT* at(Id id) const
+	{
+		NodeT*  node = find(id);
+		if(!node)
+			throw out_of_range("IdNodes::at(), the id is not mapped\n");
+		return node;
+	}
+
+    //! \brief Number of the mapped nodes
+    //!
+    //! \return size_t  - number of the nodes
+	size_t size() const  { return m_denseNum + m_sparse.size(); }
+
+    //! \brief Remove all nodes releasing the memory
+    //!
+    //! \return void
+	void clear();
+protected:
+    //! \brief Move the sparse ids to the dense table if all ids are dense enough
+    //!
+    //! \return void
+	void densify();
+};
+
 //! \brief Nodes Graph to couple nodes externally
 //! \note Back links must always exist even with zero weight
 //!
@@ -107,14 +197,18 @@ public:
     //!
     //! \param nodesNum  - estimated number of nodes
     //! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
-	Graph(Id nodesNum=0, bool shuffle=false);
+    //! 	on the finalization
+    //! \param seed=0 RandSeed  - seed of the shuffling
+	Graph(Id nodesNum=0, bool shuffle=false, RandSeed seed=0);
 
     //! \brief Reinitialize the Graph
     //! \note existent nodes will be reseted
     //!
     //! \param nodesNum  - estimated number of nodes
     //! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
-	void reinit(Id nodesNum=0, bool shuffle=false);
+    //! 	on the finalization
+    //! \param seed=0 RandSeed  - seed of the shuffling
+	void reinit(Id nodesNum=0, bool shuffle=false, RandSeed seed=0);
 
     //! \brief Add new nodes to the graph
     //! Required only to preallocate nodes and decrease number of reallocations
@@ -169,12 +263,43 @@ public:
 	template<bool DIRECTED>
 	void addNodeAndLinks(Id node, const InpLinksT& links);
 
+    //! \brief Add links specified by the flat arrays to the Graph
+    //! 	Links are grouped by the source nodes with the parallel stable sort,
+    //! 	so each node is extended once and links of the node have the same
+    //! 	order as on their sequential addition by addNodeLinks()
+    //!
+    //! \tparam DIRECTED bool  - whether links are directed
+    //! \param srcs const Id*  - source node ids
+    //! \param dsts const Id*  - dest node ids
+    //! \param weights const Weight*  - links weights, nullptr means the default
+    //! 	weight (omitted for the unweighted links)
+    //! \param num size_t  - number of links
+    //! \param create=false bool  - create unexistent nodes in place in the order
+    //! 	of the input, otherwise links must point only to already existent nodes
+    //! \param threads=1 unsigned  - number of threads, 0 means hardware threads
+    //! \return void
+	template<bool DIRECTED>
+	void addEdges(const Id* srcs, const Id* dsts, const typename InpLinkT::Weight* weights
+		, size_t num, bool create=false, unsigned threads=1);
+
+    //! \brief Reserve capacity for the subsequently added links of the node
+    //! 	Required only to allocate the node links once by the exact number
+    //! 	of links counted in advance (considering the back links of edges)
+    //! \note The node must already exist
+    //!
+    //! \param node Id  - node id
+    //! \param num Id  - number of the links to be added to the node
+    //! \return void
+	void reserveLinks(Id node, Id num);
+
     //! \brief Complete initialization and fix the Graph
 	//! that prevents it from the subsequent nodes/links extension
 	//! and releases memory occupied by the corresponding helpers
+	//! \note Nodes and links are shuffled here if the shuffling is specified
     //!
+    //! \param threads=1 unsigned  - number of threads, 0 means hardware threads
     //! \return NodesT&  - costructed nodes with links
-	NodesT& finalize();
+	NodesT& finalize(unsigned threads=1);
 
     //! \brief Whether links of nodes are directed (nonsymmentric)
     //!
@@ -184,12 +309,87 @@ protected:
     //! Validate that the Graph is applicable to be extended (not finalized)
 	void validateExtension();
 private:
-	unordered_map<Id, NodeT*>  m_idNodes;
+	IdNodes<NodeT>  m_idNodes;
 	bool  m_finalized;
 	bool  m_directed;  // Whether nodes links are directed
 	bool  m_shuffle;
+	RandSeed  m_seed;  // Seed of the shuffling
+};
+
+// Links validation -----------------------------------------------------------
+//! \brief Statistics of the links validation
+struct LinksValidation {
+	size_t  nodes;  //!< Number of the validated nodes
+	size_t  links;  //!< Number of the validated links, excluding the duplicated ones
+	size_t  duplicates;  //!< Number of the removed duplicated links
+	size_t  backLinks;  //!< Number of the added (missed) back links
+
+	LinksValidation(): nodes(0), links(0), duplicates(0), backLinks(0)  {}
+};
+
+//! \brief Validate and fix links of the nodes
+//! 	Links of each node are sorted by dest, the duplicated dests are removed
+//! 	retaining the last link of each dest (as the library validation does)
+//! 	and the links are transposed into the sources of each node, then the
+//! 	missed back links of each node are identified concurrently by the binary
+//! 	search of its sources in its links and added in bulk with zero weight
+//! 	(the default weight for the unweighted links)
+//! \note Self links do not require back links
+//!
+//! \tparam LinksT  - type of items links
+//! \param nodes Nodes<LinksT>&  - nodes to be validated
+//! \param threads=1 unsigned  - number of threads, 0 means hardware threads
+//! \return LinksValidation  - statistics of the validation
+template<typename LinksT>
+LinksValidation validateLinks(Nodes<LinksT>& nodes, unsigned threads=1);
+
+// Nodes reordering -----------------------------------------------------------
+//! \brief Shuffle (rand reorder) the nodes and links of each node
+//! 	The nodes are moved into the Fisher-Yates shuffled order and their links
+//! 	are remapped, then links of each node are shuffled concurrently. The
+//! 	random generator of each chunk of nodes is seeded by the seed and the
+//! 	chunk, so the result depends only on the seed (not on the threads)
+//! \note Links are not sorted by dest after the shuffling
+//!
+//! \tparam LinksT  - type of items links
+//! \param nodes Nodes<LinksT>&  - nodes to be shuffled
+//! \param seed RandSeed  - seed of the random generator
+//! \param threads=1 unsigned  - number of threads, 0 means hardware threads
+//! \return void
+template<typename LinksT>
+void shuffleNodes(Nodes<LinksT>& nodes, RandSeed seed, unsigned threads=1);
+
+//! \brief Order of the nodes improving locality of the links
+enum class NodesOrder {
+	NONE,  //!< Input order
+	DEGREE,  //!< Descending degrees (hubs first)
+	BFS,  //!< Breadth-first traversal from the first unvisited node
+	RCM  //!< Reverse Cuthill-McKee (min bandwidth of the adjacency matrix)
 };
 
+//! \brief Reorder the nodes to improve locality of their links
+//! 	The nodes are moved into the specified order and their links are remapped
+//! 	and sorted by dest, so neighbors of the node are close in memory and
+//! 	visited sequentially. Ids of the nodes are retained
+//!
+//! \tparam LinksT  - type of items links
+//! \param nodes Nodes<LinksT>&  - nodes to be reordered
+//! \param order NodesOrder  - order of the nodes
+//! \param threads=1 unsigned  - number of threads, 0 means hardware threads
+//! \return void
+template<typename LinksT>
+void orderNodes(Nodes<LinksT>& nodes, NodesOrder order, unsigned threads=1);
+
+//! \brief Mean span of the links: distance between the indices of the linked
+//! 	nodes, locality measure of the nodes order
+//!
+//! \tparam LinksT  - type of items links
+//! \param nodes Nodes<LinksT>&  - nodes to be evaluated
+//! \param threads=1 unsigned  - number of threads, 0 means hardware threads
+//! \return double  - mean span of the links
+template<typename LinksT>
+double linksSpan(Nodes<LinksT>& nodes, unsigned threads=1);
+
 // Clustering interface -------------------------------------------------------
 //! \brief Perform clustering and build the hierarchy
 //!
@@ -15,20 +15,95 @@
 #include <string>
 #include <cassert>
 #include <stdexcept>
-#include <cstdlib>  // srand
-#include <ctime>  // time
+#include <functional>  // less
+#include <algorithm>  // min, max, shuffle, reverse
+#include <numeric>  // iota
+#include <random>  // mt19937, seed_seq
 #include "cluster.h"
+#include "parallel.h"  // parallelSort, parallelRanges
 
 using std::string;
 using std::to_string;
 using std::out_of_range;
 using std::domain_error;
-using std::srand;
-using std::rand;
-using std::time;
 using namespace hirecs;
 
 
+// IdNodes implementation -----------------------------------------------------
+template<typename NodeT>
+void IdNodes<NodeT>::reserve(size_t num, Id idBeg)
+{
+	if(m_dense.empty())
+		m_dense.reserve(num);
+	else if(idBeg != ID_NONE && idBeg >= m_base && idBeg - m_base <= m_dense.size())
+		m_dense.reserve(idBeg - m_base + num);
+}
+
+template<typename NodeT>
+bool IdNodes<NodeT>::emplace(Id id, NodeT* node)
+{
+	if(m_dense.empty())
+		m_base = id;
+	const size_t  i = id - m_base;
+	if(id >= m_base && (i < m_dense.size() || i < 2 * size_t(m_denseNum) + DENSE_MARGIN)) {
+		if(!m_sparse.empty() && m_sparse.count(id))
+			return false;
+		if(i >= m_dense.size())
+			m_dense.resize(i + 1, nullptr);
+		else if(m_dense[i])
+			return false;
+		m_dense[i] = node;
+		++m_denseNum;
+		return true;
+	}
+	if(!m_sparse.emplace(id, node).second)
+		return false;
+	if(m_sparseMin > id)
+		m_sparseMin = id;
+	if(m_sparseMax < id)
+		m_sparseMax = id;
+	// Note: the densification costs O(size()), so it is considered when the
+	// sparse ids are numerous
+	if(m_sparse.size() >= DENSE_MARGIN && m_sparse.size() >= m_denseNum / 4)
+		densify();
+	return true;
+}
+
+template<typename NodeT>
+void IdNodes<NodeT>::densify()
+{
+	// Range of all ids, the dense table is not empty here
+	const Id  beg = m_base < m_sparseMin ? m_base : m_sparseMin;
+	const Id  last = m_base + m_dense.size() - 1 > m_sparseMax
+		? m_base + m_dense.size() - 1 : m_sparseMax;
+	if(size_t(last - beg) + 1 > 2 * size())
+		return;
+
+	vector<NodeT*>  dense(size_t(last - beg) + 1, nullptr);
+	for(size_t i = 0; i < m_dense.size(); ++i)
+		if(m_dense[i])
+			dense[m_base - beg + i] = m_dense[i];
+	for(const auto& isn: m_sparse)
+		dense[isn.first - beg] = isn.second;
+	m_dense.swap(dense);
+	m_base = beg;
+	m_denseNum += m_sparse.size();
+	m_sparse = unordered_map<Id, NodeT*>();
+	m_sparseMin = ID_NONE;
+	m_sparseMax = 0;
+}
+
+template<typename NodeT>
+void IdNodes<NodeT>::clear()
+{
+	m_dense = vector<NodeT*>();
+	m_base = 0;
+	m_denseNum = 0;
+	m_sparse = unordered_map<Id, NodeT*>();
+	m_sparseMin = ID_NONE;
+	m_sparseMax = 0;
+}
+
 // Accessory routines ---------------------------------------------------------
 //! \brief Accessory InpOperations - template argument depended wrappers
 //!
@@ -40,26 +115,17 @@ struct InpOperations {
     //! \param src NodeT*  - source node which links are extended
     //! \param dst NodeT*  - dest node
     //! \param weight WeightT  - links weight to the dest node
-    //! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
     //! \return void
 	template<typename NodeT, typename WeightT>
-	static void addLink(NodeT* src, NodeT* dst, WeightT weight, bool shuffle=false)
-	{
-		if(!shuffle)
-			src->links.emplace_back(dst, weight);
-		else src->links.emplace(src->links.begin() + rand() % src->links.size(), dst, weight);
-	}
+	static void addLink(NodeT* src, NodeT* dst, WeightT weight)
+	{ src->links.emplace_back(dst, weight); }
 };
 
 //! \copydoc InpOperations::addLink
 template<>
 template<typename NodeT, typename WeightT>
-void InpOperations<true>::addLink(NodeT* src, NodeT* dst, WeightT weight, bool shuffle)
-{
-	if(!shuffle)
-		src->links.emplace_back(dst);
-	else src->links.emplace(src->links.begin() + rand() % src->links.size(), dst);
-}
+void InpOperations<true>::addLink(NodeT* src, NodeT* dst, WeightT weight)
+{ src->links.emplace_back(dst); }
 
 //! \brief Add nodes from the user input
 //!
@@ -67,21 +133,17 @@ void InpOperations<true>::addLink(NodeT* src, NodeT* dst, WeightT weight, bool s
 //! \param idNodes IdNodesT&  - external inputted nodes
 //! \param nodesIds const NodesIdsT&  - mapping of external node Ids into the
 //! 	internal nodes
-//! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
 //! \return void
 template<typename NodesT, typename IdNodesT, typename NodesIdsT>
-void acsAddNodes(NodesT& nodes, IdNodesT& idNodes, const NodesIdsT& nodesIds, bool shuffle=false)
+void acsAddNodes(NodesT& nodes, IdNodesT& idNodes, const NodesIdsT& nodesIds)
 {
 	//nodes.reserve(nodesIds.size());
 	// Fill nodes and mapping id -> nodePtr
-	idNodes.reserve(idNodes.size() + nodesIds.size());
+	idNodes.reserve(nodesIds.size());
 	for(auto id: nodesIds) {
-		bool  iback = !shuffle || rand() % 2;
-		if(iback)
-			nodes.emplace_back(id);
-		else nodes.emplace_front(id);
-		auto ridn = idNodes.emplace(id, iback ? &nodes.back() : &nodes.front());
-		assert(ridn.second && "acsAddNodes(), input node is duplicated");
+		nodes.emplace_back(id);
+		bool  added = idNodes.emplace(id, &nodes.back());
+		assert(added && "acsAddNodes(), input node is duplicated");
 	}
 }
 
@@ -93,10 +155,9 @@ void acsAddNodes(NodesT& nodes, IdNodesT& idNodes, const NodesIdsT& nodesIds, bo
 //! \param nd NodeT*  - the node to be updated
 //! \param dst NodeT*  - destination node for the link
 //! \param weight WeightT&&  - link weight
-//! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
 //! \return void
 template<bool DIRECTED, bool WEIGHTED, typename NodeT, typename WeightT>
-void acsAddNodeLink(NodeT* nd, NodeT* dst, WeightT weight, bool shuffle=false)
+void acsAddNodeLink(NodeT* nd, NodeT* dst, WeightT weight)
 {
 	// ATTENTION: the weight is doubled on transition from Edges into Arcs in
 	// the undirected networks
@@ -110,9 +171,9 @@ void acsAddNodeLink(NodeT* nd, NodeT* dst, WeightT weight, bool shuffle=false)
 	}
 	if(!DIRECTED) {
 		weight /= 2;
-		InpOperations<!WEIGHTED>::addLink(dst, nd, weight, shuffle);
-		InpOperations<!WEIGHTED>::addLink(nd, dst, weight, shuffle);
-	} else InpOperations<!WEIGHTED>::addLink(nd, dst, weight, shuffle);
+		InpOperations<!WEIGHTED>::addLink(dst, nd, weight);
+		InpOperations<!WEIGHTED>::addLink(nd, dst, weight);
+	} else InpOperations<!WEIGHTED>::addLink(nd, dst, weight);
 }
 
 //! \brief Add node links from the user input
@@ -123,17 +184,16 @@ void acsAddNodeLink(NodeT* nd, NodeT* dst, WeightT weight, bool shuffle=false)
 //! \param idNodes const IdNodesT&  - external id - internal nodes mapping
 //! \param src Id  - external node id
 //! \param links const InpLinksT&  - external node links to be added
-//! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
 //! \return void
 template<bool DIRECTED, bool WEIGHTED, typename IdNodesT, typename InpLinksT>
-void acsAddNodeLinks(const IdNodesT& idNodes, Id src, const InpLinksT& links, bool shuffle=false)
+void acsAddNodeLinks(const IdNodesT& idNodes, Id src, const InpLinksT& links)
 {
 	// Append node links
 	Id  dstId = ID_NONE;  // Required for the exception description
 	try {
 		auto  nd = idNodes.at(src);
 		for(auto& ln: links)
-			acsAddNodeLink<DIRECTED, WEIGHTED>(nd, idNodes.at(dstId = ln.id), ln.weight, shuffle);
+			acsAddNodeLink<DIRECTED, WEIGHTED>(nd, idNodes.at(dstId = ln.id), ln.weight);
 	} catch(out_of_range& err) {
 		string cause = to_string(dstId != ID_NONE ? dstId : src).insert(0
 			, "acsAddNodeLinks(), the link with unexistent node is used: #")
@@ -148,55 +208,344 @@ void acsAddNodeLinks(const IdNodesT& idNodes, Id src, const InpLinksT& links, bo
 //! \param idNodes IdNodesT&  - external id - internal nodes mapping
 //! \param src Id  - external node id
 //! \param links const InpLinksT&  - external node links to be added
-//! \param shuffle=false bool  - shuffle (rand reorder) nodes and links
 //! \return void
 template<bool DIRECTED, bool WEIGHTED, typename NodesT, typename IdNodesT, typename InpLinksT>
-void acsAddNodeAndLinks(NodesT& nodes, IdNodesT& idNodes, Id src, const InpLinksT& links
-	, bool shuffle=false)
+void acsAddNodeAndLinks(NodesT& nodes, IdNodesT& idNodes, Id src, const InpLinksT& links)
 {
-	auto ind = idNodes.find(src);
-	if(ind == idNodes.end()) {
-		bool  iback = !shuffle || rand() % 2;
-		if(iback)
-			nodes.emplace_back(src);
-		else nodes.emplace_front(src);
-		auto ridn = idNodes.emplace(src, iback ? &nodes.back() : &nodes.front());
-		assert(ridn.second && "acsAddNodeAndLinks(), duplicated input nodes");
-		ind = ridn.first;
+	auto  nd = idNodes.find(src);
+	if(!nd) {
+		nodes.emplace_back(src);
+		nd = &nodes.back();
+		bool  added = idNodes.emplace(src, nd);
+		assert(added && "acsAddNodeAndLinks(), duplicated input nodes");
 	}
 	for(auto& ln: links) {
-		auto idst = idNodes.find(ln.id);
-		if(idst == idNodes.end()) {
-			bool  iback = !shuffle || rand() % 2;
-			if(iback)
-				nodes.emplace_back(ln.id);
-			else nodes.emplace_front(ln.id);
-			auto ridn = idNodes.emplace(ln.id, iback ? &nodes.back() : &nodes.front());
-			assert(ridn.second && "acsAddNodeAndLinks(), duplicated input nodes in links");
-			idst = ridn.first;
+		auto  dst = idNodes.find(ln.id);
+		if(!dst) {
+			nodes.emplace_back(ln.id);
+			dst = &nodes.back();
+			bool  added = idNodes.emplace(ln.id, dst);
+			assert(added && "acsAddNodeAndLinks(), duplicated input nodes in links");
+		}
+		acsAddNodeLink<DIRECTED, WEIGHTED>(nd, dst, ln.weight);
+	}
+}
+
+// Links validation -----------------------------------------------------------
+template<typename LinksT>
+LinksValidation hirecs::validateLinks(Nodes<LinksT>& nodes, unsigned threads)
+{
+	using NodeT = Node<LinksT>;
+	using LinkT = typename LinksT::value_type;
+	using DestT = decltype(LinkT::dest);
+
+	if(!threads)
+		threads = hardwareThreads();
+	LinksValidation  res;
+	// Nodes by their indices
+	vector<NodeT*>  nds;
+	nds.reserve(nodes.size());
+	for(auto& nd: nodes)
+		nds.push_back(&nd);
+	res.nodes = nds.size();
+
+	// Sort links of the nodes by dest and remove the duplicated ones
+	// Note: the last link of the duplicated dest is retained
+	auto lessDest = [](const LinkT& a, const LinkT& b) {
+		return std::less<DestT>()(a.dest, b.dest);
+	};
+	vector<size_t>  dupNums(threads, 0);
+	parallelRangesIndexed(nds.size(), [&nds, &lessDest, &dupNums](size_t beg, size_t end
+		, unsigned ithread) {
+		for(auto i = beg; i != end; ++i) {
+			auto&  links = nds[i]->links;
+			std::stable_sort(links.begin(), links.end(), lessDest);
+			auto  iend = links.begin();
+			for(auto il = links.begin(); il != links.end(); ++il) {
+				auto  iln = il + 1;
+				if(iln == links.end() || iln->dest != il->dest)
+					*iend++ = std::move(*il);
+			}
+			if(iend == links.end())
+				continue;
+			dupNums[ithread] += links.end() - iend;
+			links.erase(iend, links.end());
+		}
+	}, threads, 256);
+	for(auto dnum: dupNums)
+		res.duplicates += dnum;
+
+	// Transpose the links to identify the sources of each node
+	StoredItemsIndex<NodeT>  ndIdx(nodes);
+	vector<size_t>  offsets(nds.size() + 1, 0);  // Offsets of the links of each node
+	for(size_t i = 0; i < nds.size(); ++i)
+		offsets[i + 1] = offsets[i] + nds[i]->links.size();
+	res.links = offsets.back();
+	vector<Id>  dests(res.links);  // Indices of the dest nodes
+	parallelRanges(nds.size(), [&nds, &ndIdx, &offsets, &dests](size_t beg, size_t end) {
+		for(auto i = beg; i != end; ++i) {
+			auto  idst = dests.begin() + offsets[i];
+			for(const auto& ln: nds[i]->links)
+				*idst++ = ndIdx.at(ln.dest);
 		}
-		acsAddNodeLink<DIRECTED, WEIGHTED>(ind->second, idst->second, ln.weight, shuffle);
+	}, threads, 256);
+	ndIdx = StoredItemsIndex<NodeT>();
+	// Note: sources of each node are ordered by their indices
+	vector<size_t>  srcOffsets(nds.size() + 1, 0);  // Offsets of the sources of each node
+	for(auto idst: dests)
+		++srcOffsets[idst + 1];
+	for(size_t i = 0; i < nds.size(); ++i)
+		srcOffsets[i + 1] += srcOffsets[i];
+	vector<Id>  srcs(res.links);  // Indices of the source nodes
+	for(size_t i = 0; i < nds.size(); ++i)
+		for(auto il = offsets[i]; il != offsets[i + 1]; ++il)
+			srcs[srcOffsets[dests[il]]++] = i;
+	// Restore the offsets of the sources shifted on the filling
+	for(size_t i = nds.size(); i; --i)
+		srcOffsets[i] = srcOffsets[i - 1];
+	srcOffsets[0] = 0;
+	vector<Id>().swap(dests);
+	vector<size_t>().swap(offsets);
+
+	// Add the missed back links to each node merging them with the sorted links
+	vector<vector<DestT>>  missed(threads);  // Missed back links of the node in each thread
+	vector<size_t>  backNums(threads, 0);
+	parallelRangesIndexed(nds.size(), [&](size_t beg, size_t end, unsigned ithread) {
+		auto&  nmissed = missed[ithread];
+		for(auto i = beg; i != end; ++i) {
+			NodeT*  nd = nds[i];
+			auto&  links = nd->links;
+			nmissed.clear();
+			for(auto is = srcOffsets[i]; is != srcOffsets[i + 1]; ++is) {
+				const Id  isrc = srcs[is];
+				// Skip self links and the duplicated sources
+				if(isrc == i || (is != srcOffsets[i] && srcs[is - 1] == isrc))
+					continue;
+				const DestT  src = nds[isrc];
+				auto  ibl = std::lower_bound(links.begin(), links.end(), src
+					, [](const LinkT& bl, DestT src) { return std::less<DestT>()(bl.dest, src); });
+				if(ibl == links.end() || ibl->dest != src)
+					nmissed.push_back(src);
+			}
+			if(nmissed.empty())
+				continue;
+			std::sort(nmissed.begin(), nmissed.end(), std::less<DestT>());
+			const size_t  lnum = links.size();
+			links.reserve(lnum + nmissed.size());
+			for(auto src: nmissed)
+				InpOperations<!LinkT::IS_WEIGHTED>::addLink(nd, src, 0);
+			std::inplace_merge(links.begin(), links.begin() + lnum, links.end(), lessDest);
+			backNums[ithread] += nmissed.size();
+		}
+	}, threads, 256);
+	for(auto bnum: backNums)
+		res.backLinks += bnum;
+
+	return res;
+}
+
+// Nodes reordering -----------------------------------------------------------
+//! \brief Move the nodes into the specified order remapping their links
+//! \note Nodes are not move assignable (constant ids), so they are moved into
+//! 	the new container preserving the former one to remap the links
+//!
+//! \param nodes Nodes<LinksT>&  - nodes to be reordered
+//! \param order const vector<Id>&  - former indices of the nodes in the new order
+//! \param op LinksOpT  - operation void(LinksT& links, size_t i, unsigned ithread)
+//! 	applied to the remapped links of the reordered node i in the thread ithread
+//! \param threads unsigned  - number of threads, should be >= 1
+//! \param grain size_t  - number of nodes in the chunk
+//! \return void
+template<typename LinksT, typename LinksOpT>
+void acsReorderNodes(Nodes<LinksT>& nodes, const vector<Id>& order, LinksOpT op
+	, unsigned threads, size_t grain)
+{
+	using NodeT = Node<LinksT>;
+	using LinkT = typename LinksT::value_type;
+	using DestT = decltype(LinkT::dest);
+
+	// Nodes by their indices
+	vector<NodeT*>  nds;
+	nds.reserve(nodes.size());
+	for(auto& nd: nodes)
+		nds.push_back(&nd);
+
+	Nodes<LinksT>  ordnodes;
+	vector<NodeT*>  ordnds;  // Reordered nodes by their indices
+	ordnds.reserve(nds.size());
+	vector<DestT>  dests(nds.size());  // Dests of the reordered nodes by the former indices
+	for(size_t i = 0; i < order.size(); ++i) {
+		ordnodes.push_back(std::move(*nds[order[i]]));
+		ordnds.push_back(&ordnodes.back());
+		dests[order[i]] = ordnds[i];
 	}
+
+	// Remap the links to the reordered nodes
+	const StoredItemsIndex<NodeT>  ndIdx(nodes);
+	parallelRangesIndexed(ordnds.size(), [&](size_t beg, size_t end, unsigned ithread) {
+		for(auto i = beg; i != end; ++i) {
+			auto&  links = ordnds[i]->links;
+			for(auto& ln: links)
+				ln.dest = dests[ndIdx.at(ln.dest)];
+			op(links, i, ithread);
+		}
+	}, threads, grain);
+	nodes = std::move(ordnodes);
+}
+
+template<typename LinksT>
+void hirecs::shuffleNodes(Nodes<LinksT>& nodes, RandSeed seed, unsigned threads)
+{
+	constexpr size_t  GRAIN = 256;  // Nodes in the chunk having own random sequence
+
+	if(!threads)
+		threads = hardwareThreads();
+	// Fisher-Yates shuffle of the nodes order
+	vector<Id>  order(nodes.size());  // Former indices of the nodes in the shuffled order
+	std::iota(order.begin(), order.end(), 0);
+	std::mt19937  rnd(seed);
+	std::shuffle(order.begin(), order.end(), rnd);
+
+	// Shuffle links of each node
+	vector<std::mt19937>  rnds(threads);  // Random generator of each thread
+	acsReorderNodes(nodes, order, [seed, &rnds](LinksT& links, size_t i, unsigned ithread) {
+		auto&  lrnd = rnds[ithread];
+		// Note: the range is processed at once by the single thread
+		if(i % GRAIN == 0) {
+			std::seed_seq  sseq{seed, RandSeed(i / GRAIN)};
+			lrnd.seed(sseq);
+		}
+		std::shuffle(links.begin(), links.end(), lrnd);
+	}, threads, GRAIN);
+}
+
+template<typename LinksT>
+void hirecs::orderNodes(Nodes<LinksT>& nodes, NodesOrder order, unsigned threads)
+{
+	using LinkT = typename LinksT::value_type;
+	using DestT = decltype(LinkT::dest);
+
+	if(order == NodesOrder::NONE || nodes.size() <= 1)
+		return;
+	if(!threads)
+		threads = hardwareThreads();
+	vector<Id>  ordered;  // Former indices of the nodes in the new order
+	ordered.reserve(nodes.size());
+	{
+		// Links of the nodes by the indices in the CSR layout
+		const StoredItemsIndex<Node<LinksT>>  ndIdx(nodes);
+		vector<size_t>  offsets;  // Offsets of the links of each node
+		offsets.reserve(nodes.size() + 1);
+		offsets.push_back(0);
+		for(const auto& nd: nodes)
+			offsets.push_back(offsets.back() + nd.links.size());
+		vector<Id>  dests;  // Indices of the dest nodes
+		dests.reserve(offsets.back());
+		for(const auto& nd: nodes)
+			for(const auto& ln: nd.links)
+				dests.push_back(ndIdx.at(ln.dest));
+		auto lessDegree = [&offsets](Id a, Id b) {
+			return offsets[a + 1] - offsets[a] < offsets[b + 1] - offsets[b];
+		};
+		vector<Id>  starts(nodes.size());  // Nodes to start the traversing from
+		std::iota(starts.begin(), starts.end(), 0);
+		if(order == NodesOrder::DEGREE) {
+			parallelSort(starts.begin(), starts.end(), [&lessDegree](Id a, Id b) {
+				return lessDegree(b, a);
+			}, threads);
+			ordered = std::move(starts);
+		} else {
+			// Note: RCM traverses each connected component from the node of the
+			// min degree visiting the neighbors in the order of their degrees
+			const bool  rcm = order == NodesOrder::RCM;
+			if(rcm)
+				parallelSort(starts.begin(), starts.end(), lessDegree, threads);
+			vector<bool>  visited(nodes.size(), false);
+			for(auto is: starts) {
+				if(visited[is])
+					continue;
+				visited[is] = true;
+				ordered.push_back(is);
+				for(size_t io = ordered.size() - 1; io != ordered.size(); ++io) {
+					const size_t  inbs = ordered.size();  // Begin of the neighbors
+					for(auto il = offsets[ordered[io]]; il != offsets[ordered[io] + 1]; ++il) {
+						const Id  idst = dests[il];
+						if(!visited[idst]) {
+							visited[idst] = true;
+							ordered.push_back(idst);
+						}
+					}
+					if(rcm)
+						std::stable_sort(ordered.begin() + inbs, ordered.end(), lessDegree);
+				}
+			}
+			if(rcm)
+				std::reverse(ordered.begin(), ordered.end());
+		}
+	}
+
+	// Note: links are sorted by dest for the sequential access to the neighbors
+	acsReorderNodes(nodes, ordered, [](LinksT& links, size_t, unsigned) {
+		std::stable_sort(links.begin(), links.end(), [](const LinkT& a, const LinkT& b) {
+			return std::less<DestT>()(a.dest, b.dest);
+		});
+	}, threads, 256);
+}
+
+template<typename LinksT>
+double hirecs::linksSpan(Nodes<LinksT>& nodes, unsigned threads)
+{
+	using NodeT = Node<LinksT>;
+
+	if(!threads)
+		threads = hardwareThreads();
+	vector<NodeT*>  nds;
+	nds.reserve(nodes.size());
+	for(auto& nd: nodes)
+		nds.push_back(&nd);
+	const StoredItemsIndex<NodeT>  ndIdx(nodes);
+	vector<double>  spans(threads, 0);  // Accumulated spans of the links in each thread
+	vector<size_t>  lnums(threads, 0);  // Number of the links in each thread
+	parallelRangesIndexed(nds.size(), [&](size_t beg, size_t end, unsigned ithread) {
+		uint64_t  span = 0;
+		size_t  lnum = 0;
+		for(auto i = beg; i != end; ++i) {
+			for(const auto& ln: nds[i]->links) {
+				const Id  idst = ndIdx.at(ln.dest);
+				span += idst < i ? i - idst : idst - i;
+			}
+			lnum += nds[i]->links.size();
+		}
+		spans[ithread] += span;
+		lnums[ithread] += lnum;
+	}, threads);
+	double  span = 0;
+	size_t  lnum = 0;
+	for(unsigned i = 0; i < threads; ++i) {
+		span += spans[i];
+		lnum += lnums[i];
+	}
+	return lnum ? span / lnum : 0;
 }
 
 // External Input interfaces implementation -----------------------------------
 template<bool WEIGHTED, bool UNSIGNED>
-Graph<WEIGHTED, UNSIGNED>::Graph(Id nodesNum, bool shuffle)
-: nodes(), m_idNodes(), m_finalized(false), m_directed(false), m_shuffle(false)
+Graph<WEIGHTED, UNSIGNED>::Graph(Id nodesNum, bool shuffle, RandSeed seed)
+: nodes(), m_idNodes(), m_finalized(false), m_directed(false), m_shuffle(shuffle)
+, m_seed(seed)
 {
 	m_idNodes.reserve(nodesNum);
-	srand(time(nullptr));
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
-void Graph<WEIGHTED, UNSIGNED>::reinit(Id nodesNum, bool shuffle)
+void Graph<WEIGHTED, UNSIGNED>::reinit(Id nodesNum, bool shuffle, RandSeed seed)
 {
 	nodes.clear();
 	m_directed = false;
 	m_idNodes.clear();
 	m_idNodes.reserve(nodesNum);
 	m_shuffle = shuffle;
-	srand(time(nullptr));
+	m_seed = seed;
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
@@ -210,14 +559,14 @@ template<bool WEIGHTED, bool UNSIGNED>
 void Graph<WEIGHTED, UNSIGNED>::addNodes(const Ids& nodesIds)
 {
 	validateExtension();
-	acsAddNodes(nodes, m_idNodes, nodesIds, m_shuffle);
+	acsAddNodes(nodes, m_idNodes, nodesIds);
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
 void Graph<WEIGHTED, UNSIGNED>::addNodes(initializer_list<Id> nodesIds)
 {
 	validateExtension();
-	acsAddNodes(nodes, m_idNodes, nodesIds, m_shuffle);
+	acsAddNodes(nodes, m_idNodes, nodesIds);
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
@@ -227,15 +576,12 @@ void Graph<WEIGHTED, UNSIGNED>::addNodes(Id idBeg, Id idEnd)
 	if(idEnd < idBeg)
 		throw domain_error("addNodes(), idEnd must be >= idBeg\n");
 	// Fill nodes and mapping id -> nodePtr
-	m_idNodes.reserve(m_idNodes.size() + idEnd - idBeg);
+	// Note: the solid range is mapped by the dense table
+	m_idNodes.reserve(idEnd - idBeg, idBeg);
 	for(auto id = idBeg; id != idEnd; ++id) {
-		//fprintf(stderr, "> nodes are shuffled: %d, r: %d\n", m_shuffle, rand() % 2);
-		bool iback = !m_shuffle || rand() % 2;
-		if(iback)
-			nodes.emplace_back(id);
-		else nodes.emplace_front(id);
-		auto idn = m_idNodes.emplace(id, iback ? &nodes.back() : &nodes.front());
-		assert(idn.second && "addNodes(), input node is duplicated");
+		nodes.emplace_back(id);
+		bool  added = m_idNodes.emplace(id, &nodes.back());
+		assert(added && "addNodes(), input node is duplicated");
 	}
 }
 
@@ -245,7 +591,7 @@ void Graph<WEIGHTED, UNSIGNED>::addNodeLinks(Id node, const InpLinksT& links)
 {
 	validateExtension();
 	m_directed |= DIRECTED;
-	acsAddNodeLinks<DIRECTED, WEIGHTED>(m_idNodes, node, links, m_shuffle);
+	acsAddNodeLinks<DIRECTED, WEIGHTED>(m_idNodes, node, links);
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
@@ -255,7 +601,7 @@ void Graph<WEIGHTED, UNSIGNED>::addNodeLinks(Id node
 {
 	validateExtension();
 	m_directed |= DIRECTED;
-	acsAddNodeLinks<DIRECTED, WEIGHTED>(m_idNodes, node, links, m_shuffle);
+	acsAddNodeLinks<DIRECTED, WEIGHTED>(m_idNodes, node, links);
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
@@ -264,14 +610,161 @@ void Graph<WEIGHTED, UNSIGNED> ::addNodeAndLinks(Id node, const InpLinksT& links
 {
 	validateExtension();
 	m_directed |= DIRECTED;
-	acsAddNodeAndLinks<DIRECTED, WEIGHTED>(nodes, m_idNodes, node, links, m_shuffle);
+	acsAddNodeAndLinks<DIRECTED, WEIGHTED>(nodes, m_idNodes, node, links);
 }
 
 template<bool WEIGHTED, bool UNSIGNED>
-auto Graph<WEIGHTED, UNSIGNED>::finalize() -> NodesT&
+template<bool DIRECTED>
+void Graph<WEIGHTED, UNSIGNED>::addEdges(const Id* srcs, const Id* dsts
+	, const typename InpLinkT::Weight* weights, size_t num, bool create, unsigned threads)
 {
-	m_idNodes.clear();
-	m_finalized = true;
+	using Weight = typename InpLinkT::Weight;
+
+	validateExtension();
+	m_directed |= DIRECTED;
+	if(!threads)
+		threads = hardwareThreads();
+
+	// Internal node of the id
+	auto nodeOf = [this, create](Id nid) -> NodeT* {
+		NodeT*  nd = m_idNodes.find(nid);
+		if(!nd) {
+			if(!create)
+				throw out_of_range(to_string(nid).insert(0
+					, "addEdges(), the link with unexistent node is used: #") += '\n');
+			nodes.emplace_back(nid);
+			nd = &nodes.back();
+			m_idNodes.emplace(nid, nd);
+		}
+		return nd;
+	};
+	auto weight = [weights](size_t i) -> Weight {
+		return WEIGHTED && weights ? weights[i] : SimpleLink<LinkWeight<UNSIGNED>>::weight;
+	};
+	// Range of the node ids
+	Id  idMin = ID_NONE;
+	Id  idMax = 0;
+	for(size_t i = 0; i < num; ++i) {
+		idMin = std::min(idMin, std::min(srcs[i], dsts[i]));
+		idMax = std::max(idMax, std::max(srcs[i], dsts[i]));
+	}
+	const size_t  range = num ? size_t(idMax - idMin) + 1 : 0;
+	if(range <= 2 * (num + m_idNodes.size())) {
+		// The ids are compact enough to count the links of the nodes by the
+		// id offsets, so the links are added in the order of the input to the
+		// nodes with the exactly reserved capacity
+		// Note: nodes are created in the order of the input
+		vector<Id>  degrees(range);
+		for(size_t i = 0; i < num; ++i) {
+			NodeT*  src = nodeOf(srcs[i]);
+			if(nodeOf(dsts[i]) == src)
+				continue;
+			++degrees[srcs[i] - idMin];
+			if(!DIRECTED)
+				++degrees[dsts[i] - idMin];
+		}
+		parallelRanges(range, [this, &degrees, idMin](size_t beg, size_t end) {
+			for(auto i = beg; i != end; ++i)
+				if(degrees[i]) {
+					NodeT*  nd = m_idNodes.find(idMin + i);
+					nd->links.reserve(nd->links.size() + degrees[i]);
+				}
+		}, threads);
+		for(size_t i = 0; i < num; ++i)
+			acsAddNodeLink<DIRECTED, WEIGHTED>(m_idNodes.find(srcs[i])
+				, m_idNodes.find(dsts[i]), weight(i));
+		return;
+	}
+
+	// Form the arcs: an arc per directed link, two arcs per undirected one
+	// (the back arc is the first) with the halved weight, a single arc per the
+	// self link (the back arc has no source)
+	struct Arc {
+		NodeT*  src;
+		NodeT*  dst;
+		Weight  weight;
+	};
+	constexpr size_t  ARCS = DIRECTED ? 1 : 2;  // Arcs per link
+	vector<Arc>  arcs(num * ARCS);
+	auto formArcs = [&](size_t beg, size_t end) {
+		for(auto i = beg; i != end; ++i) {
+			NodeT*  src = nodeOf(srcs[i]);
+			NodeT*  dst = nodeOf(dsts[i]);
+			Weight  w = weight(i);
+			if(DIRECTED)
+				arcs[i] = Arc{src, dst, w};
+			else if(src != dst) {
+				w /= 2;
+				arcs[2 * i] = Arc{dst, src, w};
+				arcs[2 * i + 1] = Arc{src, dst, w};
+			} else {
+				arcs[2 * i] = Arc{src, dst, w};
+				arcs[2 * i + 1] = Arc{nullptr, nullptr, w};
+			}
+		}
+	};
+	// Note: nodes are created sequentially, the lookups are thread safe
+	if(create)
+		formArcs(0, num);
+	else parallelRanges(num, [&formArcs](size_t beg, size_t end) {
+		formArcs(beg, end);
+	}, threads);
+
+	// Group the arcs by the source nodes preserving the input order
+	std::less<NodeT*>  less;
+	parallelSort(arcs.begin(), arcs.end(), [&less](const Arc& a, const Arc& b) {
+		return less(a.src, b.src);
+	}, threads);
+
+	// Extend the nodes, each node is processed by the chunk where its arcs start
+	parallelRanges(arcs.size(), [&arcs](size_t beg, size_t end) {
+		while(beg != end && beg && arcs[beg].src == arcs[beg - 1].src)
+			++beg;
+		for(size_t ia = beg; ia < end;) {
+			NodeT*  nd = arcs[ia].src;
+			size_t  iae = ia;
+			Id  lnum = 0;
+			for(; iae != arcs.size() && arcs[iae].src == nd; ++iae)
+				lnum += arcs[iae].dst != nd;
+			if(!nd) {
+				ia = iae;
+				continue;
+			}
+			nd->links.reserve(nd->links.size() + lnum);
+			for(; ia != iae; ++ia) {
+				const Arc&  arc = arcs[ia];
+				if(arc.dst == nd) {
+					assert(!nd->selfWeight()
+						&& "addEdges(), selfweight can be initialized just once");
+					// Note: the self weight is doubled like in acsAddNodeLink()
+					nd->selfWeight(arc.weight * (1 + (!WEIGHTED && !DIRECTED)));
+				} else InpOperations<!WEIGHTED>::addLink(nd, arc.dst, arc.weight);
+			}
+		}
+	}, threads);
+}
+
+template<bool WEIGHTED, bool UNSIGNED>
+void Graph<WEIGHTED, UNSIGNED>::reserveLinks(Id node, Id num)
+{
+	validateExtension();
+	NodeT*  nd = m_idNodes.find(node);
+	if(!nd)
+		throw out_of_range(to_string(node).insert(0
+			, "reserveLinks(), unexistent node is used: #") += '\n');
+	nd->links.reserve(nd->links.size() + num);
+}
+
+template<bool WEIGHTED, bool UNSIGNED>
+auto Graph<WEIGHTED, UNSIGNED>::finalize(unsigned threads) -> NodesT&
+{
+	if(!m_finalized) {
+		m_idNodes.clear();
+		// Note: the nodes are shuffled once, the same way for the same seed
+		if(m_shuffle)
+			shuffleNodes(nodes, m_seed, threads);
+		m_finalized = true;
+	}
 	return nodes;
 }
 
@@ -0,0 +1,167 @@
+//! \brief Parallel processing of items ranges for the High Resolution Hierarchical Clustering with Stable State (HiReCS) library
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! > 	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>  // size_t
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>  // stable_sort, inplace_merge
+#include <exception>  // exception_ptr
+
+namespace hirecs {
+
+using std::size_t;
+using std::atomic;
+using std::thread;
+using std::vector;
+using std::exception_ptr;
+
+
+//! \brief Number of the hardware threads
+//!
+//! \return unsigned  - number of threads >= 1
+inline unsigned hardwareThreads()
+{
+	const unsigned  threads = thread::hardware_concurrency();
+	return threads ? threads : 1;
+}
+
+//! \brief Process the items range [0, num) by chunks in parallel
+//! 	Chunks are fetched dynamically by the threads, so the fast threads take
+//! 	the remained work of the slow ones. Results are deterministic if the
+//! 	operation writes only results of the processed items.
+//! \note The calling thread takes part in the processing with the index 0.
+//! 	The exception of the first failed chunk (in the range order) is rethrown
+//! 	after all threads are completed.
+//!
+//! \param num size_t  - number of items
+//! \param op OpT  - operation void(size_t beg, size_t end, unsigned ithread)
+//! 	processing items [beg, end) in the thread ithread E [0, threads),
+//! 	should be thread safe. The thread index allows to use the thread local
+//! 	scratch buffers allocated by the caller
+//! \param threads unsigned  - number of threads, should be >= 1
+//! \param grain=1024 size_t  - number of items in the chunk
+//! \return void
+template<typename OpT>
+void parallelRangesIndexed(size_t num, OpT op, unsigned threads, size_t grain=1024)
+{
+	if(!num)
+		return;
+	if(!grain)
+		grain = 1;
+	const size_t  chunks = (num + grain - 1) / grain;
+	if(threads > chunks)
+		threads = chunks;
+	if(threads <= 1) {
+		op(size_t(0), num, 0u);
+		return;
+	}
+
+	atomic<size_t>  ichunk(0);  // Next chunk to be processed
+	// The first failed chunk and its exception
+	vector<size_t>  errChunks(threads, chunks);
+	vector<exception_ptr>  errors(threads);
+	auto worker = [&](unsigned iw) {
+		for(size_t ic; (ic = ichunk++) < chunks;) {
+			try {
+				const size_t  beg = ic * grain;
+				op(beg, beg + grain < num ? beg + grain : num, iw);
+			} catch(...) {
+				// Note: chunks are fetched by the worker in ascending order
+				if(!errors[iw]) {
+					errChunks[iw] = ic;
+					errors[iw] = std::current_exception();
+				}
+			}
+		}
+	};
+	vector<thread>  workers;
+	workers.reserve(threads - 1);
+	for(unsigned i = 1; i < threads; ++i)
+		workers.emplace_back(worker, i);
+	worker(0);
+	for(auto& wk: workers)
+		wk.join();
+
+	// Rethrow the exception of the first failed chunk
+	unsigned  ierr = 0;
+	for(unsigned i = 1; i < threads; ++i)
+		if(errChunks[i] < errChunks[ierr])
+			ierr = i;
+	if(errors[ierr])
+		std::rethrow_exception(errors[ierr]);
+}
+
+//! \brief Process the items range [0, num) by chunks in parallel
+//! \copydetails parallelRangesIndexed()
+//!
+//! \param num size_t  - number of items
+//! \param op OpT  - operation void(size_t beg, size_t end) processing items
+//! 	[beg, end), should be thread safe
+//! \param threads=0 unsigned  - number of threads, 0 means hardware threads
+//! \param grain=1024 size_t  - number of items in the chunk
+//! \return void
+template<typename OpT>
+void parallelRanges(size_t num, OpT op, unsigned threads=0, size_t grain=1024)
+{
+	parallelRangesIndexed(num, [&op](size_t beg, size_t end, unsigned) {
+		op(beg, end);
+	}, threads ? threads : hardwareThreads(), grain);
+}
+
+//! \brief Stable sort of the items range in parallel
+//! 	The range is split into chunks sorted concurrently, then the chunks are
+//! 	merged pairwise (concurrently on each merging level)
+//!
+//! \param beg RandIt  - begin of the items range
+//! \param end RandIt  - end of the items range
+//! \param comp CompT  - comparison operation bool(const Item& a, const Item& b)
+//! 	returning true if a < b
+//! \param threads unsigned  - number of threads, should be >= 1
+//! \param grain=0x10000 size_t  - min number of items in the sorted chunk
+//! \return void
+template<typename RandIt, typename CompT>
+void parallelSort(RandIt beg, RandIt end, CompT comp, unsigned threads
+	, size_t grain=0x10000)
+{
+	const size_t  num = end - beg;
+	size_t  chunks = grain ? num / grain : num;
+	if(chunks > threads)
+		chunks = threads;
+	if(chunks <= 1) {
+		std::stable_sort(beg, end, comp);
+		return;
+	}
+
+	const size_t  width = (num + chunks - 1) / chunks;  // Items in the chunk
+	parallelRangesIndexed(chunks, [beg, num, width, &comp](size_t cb, size_t ce, unsigned) {
+		for(auto ic = cb; ic != ce; ++ic)
+			std::stable_sort(beg + ic * width, beg + std::min((ic + 1) * width, num), comp);
+	}, threads, 1);
+	// Merge the sorted ranges pairwise
+	for(size_t wd = width; wd < num; wd *= 2) {
+		parallelRangesIndexed((num + 2 * wd - 1) / (2 * wd), [beg, num, wd, &comp](
+			size_t pb, size_t pe, unsigned) {
+			for(auto ip = pb; ip != pe; ++ip) {
+				const size_t  mid = ip * 2 * wd + wd;
+				if(mid < num)
+					std::inplace_merge(beg + ip * 2 * wd, beg + mid
+						, beg + std::min(mid + wd, num), comp);
+			}
+		}, threads, 1);
+	}
+}
+
+}  // hirecs
+
+#endif // PARALLEL_H
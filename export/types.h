@@ -86,6 +86,8 @@ struct Link {
 	using WeightValT = typename WeightT::Type;  //!< \copydoc WeightT::Type
 	using DestT = Node<Links<Link>>;  //!< \copydoc Node<Links<Link>>
 
+	constexpr static bool  IS_WEIGHTED = WEIGHTED;  //!< \copydoc WEIGHTED
+
 	DestT*  dest;  //!< Destination node
 	//! Total accumulative outbound weight on this link (to the dest id)
 	WeightValT weight;
@@ -108,6 +110,9 @@ struct Link<WeightT, false> {
 	using WeightValT = typename WeightT::Type;  //!< \copydoc WeightT::Type
 	using DestT = Node<Links<Link>>;  //!< \copydoc Node<Links<Link>>
 
+	//! Link is unweighted
+	constexpr static bool  IS_WEIGHTED = false;
+
 	//! Destination node
 	DestT*  dest;
 	//! Total accumulative outbound weight on this link (to the dest id)
@@ -365,6 +370,39 @@ public:
 template<typename ItemT>
 using StoredItems = list<ItemT>;  // Note: vector<unique_ptr<ItemT>> can also be used
 
+//! Index of the stored items by their addresses
+template<typename ItemT>
+class StoredItemsIndex {
+	unordered_map<const ItemT*, size_t>  m_index;  // Indices of the items
+public:
+	StoredItemsIndex(): m_index()  {}
+
+    //! \brief Construct the index of the stored items
+    //!
+    //! \param items const StoredItems<ItemT>&  - stored items
+	explicit StoredItemsIndex(const StoredItems<ItemT>& items): StoredItemsIndex()
+	{ assign(items); }
+
+    //! \brief Index the stored items
+    //!
+    //! \param items const StoredItems<ItemT>&  - stored items
+    //! \return void
+	void assign(const StoredItems<ItemT>& items)
+	{
+		m_index.clear();
+		m_index.reserve(items.size());
+		for(const auto& item: items)
+			m_index.emplace(&item, m_index.size());
+	}
+
+    //! \brief Index of the item
+    //! \note Throws out_of_range if the item is not stored
+    //!
+    //! \param item const ItemT*  - stored item
+    //! \return size_t  - index of the item
+	size_t at(const ItemT* item) const  { return m_index.at(item); }
+};
+
 //! Container for nodes
 // Note: without unique_ptr adresses of the nodes can be invalidated on vector updating
 template<typename LinksT>
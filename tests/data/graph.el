@@ -0,0 +1,10 @@
+# Weighted undirected graph for the input formats tests (equivalent of graph.hig)
+1	2	1
+1	3	2
+2	3	1
+2	4	0.5
+3	4	1.5
+4	5	1
+4	6	1
+5	6	2
+6	6	1
@@ -0,0 +1,84 @@
+//! \brief Tests of the binary graph format (.higb)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <cstdio>  // remove
+#include <cstring>  // memcpy
+#include "tests.h"
+
+
+void testHigbRoundTrip()
+{
+	const string  higbfile = "graph.higb";
+	const string  higbfile2 = "graph2.higb";
+	convertHigb(dataFile("graph.hig"), higbfile);
+	// Edges are unfolded into the arcs with the halved weight, self links form
+	// the self weight
+	const GraphDump  gd = higbDump(higbfile);
+	check(!gd.directed && gd.nodes.size() == 6 && gd.links.size() == 16
+		, "testHigbRoundTrip(), unexpected size of the converted graph");
+	check(std::get<1>(gd.nodes.back()) == 1 && gd.links.front() == std::make_tuple(1u, 2u, 0.5f)
+		, "testHigbRoundTrip(), unexpected weights of the converted graph");
+
+	// Saving of the loaded nodes reproduces the file
+	{
+		MappedFile  infile(higbfile);
+		Graph<true>::NodesT  nodes;
+		loadHigb<true>(infile, nodes);
+		saveHigb<true>(higbfile2, nodes, higbHeader(infile).directed);
+	}
+	check(fileContent(higbfile) == fileContent(higbfile2)
+		, "testHigbRoundTrip(), the saved .higb differs from the loaded one");
+	remove(higbfile.c_str());
+	remove(higbfile2.c_str());
+}
+
+void testHigbCorrupted()
+{
+	const string  higbfile = "graph.higb";
+	const string  corrupted = "corrupted.higb";
+	convertHigb(dataFile("graph.hig"), higbfile);
+	const string  content = fileContent(higbfile);
+	HigbHeader  hdr;
+	memcpy(&hdr, content.data(), sizeof hdr);
+
+	auto checkCorrupted = [&corrupted](const string& data, const string& msg) {
+		writeFile(corrupted, data);
+		checkThrows<domain_error>([&corrupted]() {
+			MappedFile  infile(corrupted);
+			Graph<true>::NodesT  nodes;
+			loadHigb<true>(infile, nodes);
+		}, "testHigbCorrupted(), " + msg);
+	};
+	// Modify the header
+	auto withHeader = [&content](const HigbHeader& hd) {
+		string  data = content;
+		memcpy(&data[0], &hd, sizeof hd);
+		return data;
+	};
+
+	checkCorrupted(content.substr(0, content.size() - 8), "truncated file");
+	HigbHeader  hd = hdr;
+	hd.nodes = uint64_t(1) << 62;
+	checkCorrupted(withHeader(hd), "huge number of nodes");
+	hd = hdr;
+	hd.links = ~uint64_t(0) / 2;
+	checkCorrupted(withHeader(hd), "huge number of links");
+	hd = hdr;
+	++hd.nodes;
+	checkCorrupted(withHeader(hd), "number of nodes exceeding the arrays");
+	// Decreasing offsets
+	string  data = content;
+	const size_t  offsetsPos = higbArraySize(1, sizeof hdr) + 2 * higbArraySize(hdr.nodes, sizeof(Id));
+	const uint64_t  offset = hdr.links;
+	memcpy(&data[offsetsPos + sizeof offset], &offset, sizeof offset);
+	checkCorrupted(data, "decreasing offsets of the links");
+	remove(higbfile.c_str());
+	remove(corrupted.c_str());
+}
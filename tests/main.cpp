@@ -0,0 +1,124 @@
+//! \brief Tests runner of the High Resolution Hierarchical Clustering with Stable State (HiReCS) library and client
+//! 	Runs all tests or the specified ones from the tests directory
+//! 	(test data are in ./data)
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <cstring>  // strcmp, strlen
+#include <exception>
+#include <utility>  // pair
+#include "tests.h"
+
+using std::pair;
+using std::exception;
+
+
+// Helpers implementation -----------------------------------------------------
+void runClient(const vector<string>& args)
+{
+	vector<string>  argstrs(1, "hirecs");
+	argstrs.insert(argstrs.end(), args.begin(), args.end());
+	vector<char*>  argv;
+	for(auto& arg: argstrs)
+		argv.push_back(&arg[0]);
+	Client  client;
+	if(!client.parseArgs(argv.size(), argv.data()))
+		throw logic_error("runClient(), invalid arguments\n");
+	client.process();
+}
+
+void convertHigb(const string& inpfile, const string& higbfile
+	, const vector<string>& opts)
+{
+	vector<string>  args(opts);
+	args.push_back("-b" + higbfile);
+	args.push_back(inpfile);
+	runClient(args);
+}
+
+string fileContent(const string& filename)
+{
+	FILE*  fin = fopen(filename.c_str(), "rb");
+	if(!fin)
+		throw logic_error("fileContent(), the file can't be opened: " + filename + '\n');
+	string  content;
+	char  buf[4096];
+	for(size_t num; (num = fread(buf, 1, sizeof buf, fin)) > 0;)
+		content.append(buf, num);
+	fclose(fin);
+	return content;
+}
+
+void writeFile(const string& filename, const string& content)
+{
+	FILE*  fout = fopen(filename.c_str(), "wb");
+	if(!fout || fwrite(content.data(), 1, content.size(), fout) != content.size()) {
+		if(fout)
+			fclose(fout);
+		throw logic_error("writeFile(), the file can't be written: " + filename + '\n');
+	}
+	fclose(fout);
+}
+
+GraphDump higbDump(const string& higbfile)
+{
+	MappedFile  infile(higbfile);
+	GraphDump  gd;
+	if(higbHeader(infile).weighted) {
+		Graph<true>::NodesT  nodes;
+		loadHigb<true>(infile, nodes);
+		gd.assign(nodes, higbHeader(infile).directed);
+	} else {
+		Graph<false>::NodesT  nodes;
+		loadHigb<false>(infile, nodes);
+		gd.assign(nodes, higbHeader(infile).directed);
+	}
+	return gd;
+}
+
+// Tests runner ---------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	// Note: the tests are executed in the order of the declaration
+	const pair<const char*, void (*)()>  tests[] = {
+		{"higbRoundTrip", testHigbRoundTrip},
+		{"higbCorrupted", testHigbCorrupted},
+		{"parallelRanges", testParallelRanges},
+		{"parallelSort", testParallelSort},
+		{"readersEquivalence", testReadersEquivalence},
+		{"readersDuplicates", testReadersDuplicates},
+		{"readersSelfLinks", testReadersSelfLinks},
+		{"readersStreamed", testReadersStreamed},
+		{"validationLinks", testValidationLinks},
+		{"validationLibrary", testValidationLibrary}
+	};
+
+	unsigned  executed = 0;
+	unsigned  failed = 0;
+	for(const auto& test: tests) {
+		// Execute only the specified tests if any
+		if(argc >= 2 && std::find_if(argv + 1, argv + argc, [&test](const char* name) {
+			return !strcmp(name, test.first);
+		}) == argv + argc)
+			continue;
+		++executed;
+		try {
+			test.second();
+			fprintf(stderr, "+ %s\n", test.first);
+		} catch(exception& err) {
+			++failed;
+			// Note: the library exceptions end with the new line
+			const size_t  msglen = strlen(err.what());
+			fprintf(stderr, "- %s FAILED: %s%s", test.first, err.what()
+				, msglen && err.what()[msglen - 1] == '\n' ? "" : "\n");
+		}
+	}
+	fprintf(stderr, "Tests passed: %u / %u\n", executed - failed, executed);
+	return failed != 0;
+}
@@ -0,0 +1,71 @@
+//! \brief Tests of the parallel processing of items ranges
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <random>
+#include <utility>  // pair
+#include "parallel.h"
+#include "tests.h"
+
+using std::pair;
+
+
+void testParallelRanges()
+{
+	const size_t  num = 10007;
+	for(unsigned threads = 1; threads <= 4; ++threads) {
+		// Each item is processed exactly once by a valid thread
+		vector<unsigned>  hits(num, 0);
+		bool  validThreads = true;
+		parallelRangesIndexed(num, [&hits, &validThreads, threads](size_t beg, size_t end
+			, unsigned ithread) {
+			if(ithread >= threads)
+				validThreads = false;
+			for(auto i = beg; i != end; ++i)
+				++hits[i];
+		}, threads, 100);
+		check(validThreads, "testParallelRanges(), invalid thread index");
+		check(std::count(hits.begin(), hits.end(), 1u) == num
+			, "testParallelRanges(), items should be processed exactly once");
+
+		// The exception of the first failed chunk is rethrown
+		size_t  failed = 0;
+		try {
+			parallelRanges(num, [](size_t beg, size_t end) {
+				for(auto i = beg; i != end; ++i)
+					if(i == 3000 || i == 7000)
+						throw logic_error(std::to_string(i));
+			}, threads, 1000);
+		} catch(logic_error& err) {
+			failed = std::stoul(err.what());
+		}
+		check(failed == 3000, "testParallelRanges(), the first failed chunk is expected");
+	}
+}
+
+void testParallelSort()
+{
+	std::mt19937  rnd(1);
+	std::uniform_int_distribution<unsigned>  rkey(0, 100);
+	// Duplicated keys check the stability
+	vector<pair<unsigned, unsigned>>  items;
+	for(unsigned i = 0; i < 10007; ++i)
+		items.emplace_back(rkey(rnd), i);
+	auto lessKey = [](const pair<unsigned, unsigned>& a, const pair<unsigned, unsigned>& b) {
+		return a.first < b.first;
+	};
+	auto  expected = items;
+	std::stable_sort(expected.begin(), expected.end(), lessKey);
+	for(unsigned threads = 1; threads <= 5; ++threads) {
+		auto  sorted = items;
+		parallelSort(sorted.begin(), sorted.end(), lessKey, threads, 1000);
+		check(sorted == expected, "testParallelSort(), the result differs from the stable sort, threads: "
+			+ std::to_string(threads));
+	}
+}
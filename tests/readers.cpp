@@ -0,0 +1,173 @@
+//! \brief Tests of the input graph formats readers
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include <cstdio>  // remove
+#include <thread>
+#include <fcntl.h>  // open
+#include <unistd.h>  // close
+#include <sys/stat.h>  // mkfifo
+#include "tests.h"
+
+using std::thread;
+
+
+//! \brief Load the graph by the client into the canonical form
+//!
+//! \param inpfile const string&  - input graph
+//! \param opts=vector<string>() const vector<string>&  - additional options
+//! \return GraphDump  - canonical graph
+GraphDump loadDump(const string& inpfile, const vector<string>& opts=vector<string>())
+{
+	const string  higbfile = "readers.higb";
+	convertHigb(inpfile, higbfile, opts);
+	GraphDump  gd = higbDump(higbfile);
+	remove(higbfile.c_str());
+	return gd;
+}
+
+void testReadersEquivalence()
+{
+	const GraphDump  expected = loadDump(dataFile("graph.hig"));
+	check(!expected.links.empty(), "testReadersEquivalence(), the .hig graph is empty");
+	for(const char* name: {"graph.net", "graph.mtx"})
+		check(loadDump(dataFile(name)) == expected, string("testReadersEquivalence()"
+			", the graph differs from the .hig one: ") + name);
+	// Weights of the edge list are loaded only on request
+	check(loadDump(dataFile("graph.el"), vector<string>(1, "-e")) == expected
+		, "testReadersEquivalence(), the graph differs from the .hig one: graph.el");
+	// Without -e the weights column is omitted like the absent one
+	const string  nwfile = "noweights.el";
+	writeFile(nwfile, "1 2\n1 3\n2 3\n2 4\n3 4\n4 5\n4 6\n5 6\n6 6\n");
+	const GraphDump  noweights = loadDump(nwfile, vector<string>(1, "-e"));
+	remove(nwfile.c_str());
+	check(loadDump(dataFile("graph.el")) == noweights
+		, "testReadersEquivalence(), the third column of the edge list is loaded as the weight");
+
+	// Unknown extensions are not taken as edge lists implicitly
+	const string  txtfile = "graph.txt";
+	writeFile(txtfile, fileContent(dataFile("graph.el")));
+	checkThrows<domain_error>([&txtfile] { loadDump(txtfile); }
+		, "testReadersEquivalence(), loading of the unknown extension");
+	check(loadDump(txtfile, {"-iel", "-e"}) == expected
+		, "testReadersEquivalence(), the edge list differs from the .hig one: graph.txt");
+	remove(txtfile.c_str());
+
+	// Self links are not representable in METIS
+	GraphDump  noself = expected;
+	std::get<1>(noself.nodes.back()) = 0;
+	check(loadDump(dataFile("graph.graph")) == noself
+		, "testReadersEquivalence(), the graph differs from the .hig one: graph.graph");
+}
+
+void testReadersDuplicates()
+{
+	const GraphDump  expected = loadDump(dataFile("graph.hig"));
+	const vector<string>  resdub(1, "-d");
+	const vector<string>  elresdub = {"-d", "-e"};
+
+	// The last weight of the duplicated link is used, opposite undirected
+	// links of the edge list are also duplicates
+	const string  elfile = "duplicates.el";
+	writeFile(elfile, "1 2 5\n3 1 7\n" + fileContent(dataFile("graph.el")));
+	check(loadDump(elfile, elresdub) == expected
+		, "testReadersDuplicates(), duplicated links of the edge list are not resolved");
+	remove(elfile.c_str());
+
+	const string  netfile = "duplicates.net";
+	string  content = fileContent(dataFile("graph.net"));
+	content.insert(content.find("*Edges\n") + 7, "1 2 5\n4 6 3\n");
+	writeFile(netfile, content);
+	check(loadDump(netfile, resdub) == expected
+		, "testReadersDuplicates(), duplicated links of the Pajek file are not resolved");
+	remove(netfile.c_str());
+}
+
+void testReadersSelfLinks()
+{
+	// Self links of the undirected links are loaded the same way by all
+	// readers, including the unweighted graph, where the self weight is doubled
+	auto load = [](const string& name, InputFormat fmt) {
+		MappedFile  infile(dataFile(name));
+		Graph<false>  graph;
+		auto makeGraph = [&graph](Id nodesNum, Id startId) -> Graph<false>& {
+			graph.reinit(nodesNum);
+			if(startId != ID_NONE)
+				graph.addNodes(startId, startId + nodesNum);
+			return graph;
+		};
+		if(fmt == InputFormat::PAJEK)
+			loadPajek<false>(infile, false, makeGraph);
+		else if(fmt == InputFormat::EDGELIST)
+			loadEdgeList<false>(infile, false, false, false, makeGraph);
+		else loadMtx<false>(infile, false, makeGraph);
+		GraphDump  gd;
+		gd.assign(graph.finalize(), graph.directed());
+		return gd;
+	};
+	const GraphDump  expected = load("graph.el", InputFormat::EDGELIST);
+	check(!expected.directed && std::get<1>(expected.nodes.back()) == 2
+		, "testReadersSelfLinks(), unexpected self weight of the unweighted edge list");
+	check(load("graph.net", InputFormat::PAJEK) == expected
+		, "testReadersSelfLinks(), the unweighted Pajek graph differs from the edge list");
+	check(load("graph.mtx", InputFormat::MTX) == expected
+		, "testReadersSelfLinks(), the unweighted Matrix Market graph differs from the edge list");
+}
+
+void testReadersStreamed()
+{
+	const GraphDump  expected = loadDump(dataFile("graph.hig"));
+
+	// Gzip compressed .hig
+	const string  gzfile = "graph.hig.gz";
+	{
+		const string  content = fileContent(dataFile("graph.hig"));
+		gzFile  fout = gzopen(gzfile.c_str(), "wb");
+		check(fout && gzwrite(fout, content.data(), content.size()) == int(content.size())
+			&& gzclose(fout) == Z_OK, "testReadersStreamed(), the gzip file can't be written");
+	}
+	check(loadDump(gzfile) == expected
+		, "testReadersStreamed(), the gzip graph differs from the .hig one");
+
+	// Gzip compressed .hig from stdin
+	check(freopen(gzfile.c_str(), "rb", stdin)
+		, "testReadersStreamed(), stdin can't be redirected");
+	const GraphDump  gd = loadDump("-");
+	remove(gzfile.c_str());
+	check(gd == expected, "testReadersStreamed(), the stdin graph differs from the .hig one");
+
+	// .hig from the named pipe, which has no size like the process substitution
+	const string  fifo = "graph.fifo";
+	remove(fifo.c_str());
+	check(!mkfifo(fifo.c_str(), 0600), "testReadersStreamed(), the fifo can't be created");
+	const string  content = fileContent(dataFile("graph.hig"));
+	// Note: the writer is blocked until the client opens the pipe
+	thread  writer([&fifo, &content] {
+		FILE*  fout = fopen(fifo.c_str(), "wb");
+		if(fout) {
+			fwrite(content.data(), 1, content.size(), fout);
+			fclose(fout);
+		}
+	});
+	GraphDump  fgd;
+	try {
+		fgd = loadDump(fifo);
+	} catch(...) {
+		// Release the writer if the pipe was not opened by the client
+		int  fd = open(fifo.c_str(), O_RDONLY | O_NONBLOCK);
+		writer.join();
+		if(fd != -1)
+			close(fd);
+		remove(fifo.c_str());
+		throw;
+	}
+	writer.join();
+	remove(fifo.c_str());
+	check(fgd == expected, "testReadersStreamed(), the fifo graph differs from the .hig one");
+}
@@ -0,0 +1,9 @@
+#!/bin/sh
+# Build and run the tests (all or the specified ones) against the library in ../bin/Release
+# Note: the prebuilt library uses the former (pre C++11) ABI of libstdc++
+cd "$(dirname "$0")"
+mkdir -p bin/Release
+g++ -std=c++11 -O2 -Wall -pthread -D_GLIBCXX_USE_CXX11_ABI=0 -I../export -I../client/include \
+	*.cpp ../client/src/client.cpp ../client/src/fileio.cpp -o bin/Release/tests \
+	-L../bin/Release -lhirecs -Wl,-rpath,'$ORIGIN/../../../bin/Release' -lz \
+&& bin/Release/tests "$@"
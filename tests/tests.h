@@ -0,0 +1,143 @@
+//! \brief Tests of the High Resolution Hierarchical Clustering with Stable State (HiReCS) library and client
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+#ifndef TESTS_H
+#define TESTS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <algorithm>  // sort
+#include <stdexcept>  // logic_error
+#include "client.h"
+
+using std::string;
+using std::vector;
+using std::tuple;
+using std::logic_error;
+
+
+// Tests ----------------------------------------------------------------------
+void testHigbRoundTrip();
+void testHigbCorrupted();
+void testParallelRanges();
+void testParallelSort();
+void testReadersEquivalence();
+void testReadersDuplicates();
+void testReadersSelfLinks();
+void testReadersStreamed();
+void testValidationLinks();
+void testValidationLibrary();
+
+// Helpers --------------------------------------------------------------------
+//! \brief Check the condition of the test
+//!
+//! \param cond bool  - condition to be held
+//! \param msg const string&  - description of the failed condition
+//! \return void
+inline void check(bool cond, const string& msg)
+{
+	if(!cond)
+		throw logic_error(msg + '\n');
+}
+
+//! \brief Check that the operation throws the exception
+//!
+//! \tparam ExceptionT  - expected exception type
+//! \param op OpT  - operation: void op()
+//! \param msg const string&  - description of the operation
+//! \return void
+template<typename ExceptionT, typename OpT>
+void checkThrows(OpT op, const string& msg)
+{
+	try {
+		op();
+	} catch(const ExceptionT&) {
+		return;
+	}
+	throw logic_error(msg + ": the exception is expected\n");
+}
+
+//! Path of the test data file
+inline string dataFile(const string& name)  { return "data/" + name; }
+
+//! \brief Run the client with the specified arguments
+//!
+//! \param args const vector<string>&  - arguments excluding the executable
+//! \return void
+void runClient(const vector<string>& args);
+
+//! \brief Convert the input graph into the .higb file by the client
+//!
+//! \param inpfile const string&  - input graph
+//! \param higbfile const string&  - resulting .higb file
+//! \param opts=vector<string>() const vector<string>&  - additional options
+//! \return void
+void convertHigb(const string& inpfile, const string& higbfile
+	, const vector<string>& opts=vector<string>());
+
+//! \brief Content of the file
+//!
+//! \param filename const string&  - file name
+//! \return string  - content of the file
+string fileContent(const string& filename);
+
+//! \brief Write the content into the file
+//!
+//! \param filename const string&  - file name
+//! \param content const string&  - content to be written
+//! \return void
+void writeFile(const string& filename, const string& content);
+
+//! \brief Graph in the canonical form to compare the graphs independently
+//! 	of the nodes and links order
+struct GraphDump {
+	bool  directed;  //!< Whether the links are directed
+	vector<tuple<Id, float>>  nodes;  //!< Ids and self weights of the nodes, sorted
+	vector<tuple<Id, Id, float>>  links;  //!< Source and dest ids and weights of the links, sorted
+
+	GraphDump(): directed(false), nodes(), links()  {}
+
+	bool operator==(const GraphDump& gd) const
+	{ return directed == gd.directed && nodes == gd.nodes && links == gd.links; }
+	bool operator!=(const GraphDump& gd) const  { return !(*this == gd); }
+
+    //! \brief Form the dump from the nodes
+    //!
+    //! \param nodes const NodesT&  - nodes with links
+    //! \param directed bool  - whether the links are directed
+    //! \return void
+	template<typename NodesT>
+	void assign(const NodesT& nodes, bool directed);
+};
+
+//! \brief Load the graph dump from the .higb file
+//!
+//! \param higbfile const string&  - .higb file
+//! \return GraphDump  - canonical graph
+GraphDump higbDump(const string& higbfile);
+
+// Helpers definitions --------------------------------------------------------
+template<typename NodesT>
+void GraphDump::assign(const NodesT& nodes, bool directed)
+{
+	this->directed = directed;
+	this->nodes.clear();
+	links.clear();
+	for(const auto& nd: nodes) {
+		this->nodes.emplace_back(nd.id, nd.selfWeight());
+		for(const auto& ln: nd.links)
+			links.emplace_back(nd.id, ln.dest->id, float(ln.weight));
+	}
+	std::sort(this->nodes.begin(), this->nodes.end());
+	std::sort(links.begin(), links.end());
+}
+
+#endif // TESTS_H
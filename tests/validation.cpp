@@ -0,0 +1,118 @@
+//! \brief Tests of the links validation
+//!
+//! \license Apache License, Version 2.0: http://www.apache.org/licenses/LICENSE-2.0.html
+//! >	Simple explanation: https://tldrlegal.com/license/apache-license-2.0-(apache-2.0)
+//!
+//! Copyright (c)
+//! \authr Artem Lutov
+//! \email luart@ya.ru
+//! \date 2026-10-16
+
+#include "tests.h"
+
+using std::make_tuple;
+using std::pair;
+
+
+void testValidationLinks()
+{
+	// Duplicated links retain the last one, the one-sided links get the back
+	// links with zero weight
+	GraphDump  expected;
+	expected.directed = true;
+	for(Id i = 1; i <= 4; ++i)
+		expected.nodes.emplace_back(i, 0);
+	expected.links = {make_tuple(1, 2, 5), make_tuple(1, 3, 2), make_tuple(1, 4, 0)
+		, make_tuple(2, 1, 1), make_tuple(3, 1, 0), make_tuple(4, 1, 4)};
+	for(unsigned threads = 1; threads <= 3; ++threads) {
+		Graph<true>  graph(4);
+		graph.addNodes(1, 5);
+		graph.addNodeLinks<true>(1, {{2, 1}, {3, 2}, {2, 5}});
+		graph.addNodeLinks<true>(2, {{1, 1}});
+		graph.addNodeLinks<true>(4, {{1, 3}, {1, 4}});
+		auto&  nodes = graph.finalize();
+		const auto  lval = validateLinks(nodes, threads);
+		check(lval.nodes == 4 && lval.links == 4 && lval.duplicates == 2 && lval.backLinks == 2
+			, "testValidationLinks(), unexpected statistics, threads: " + std::to_string(threads));
+		GraphDump  gd;
+		gd.assign(nodes, true);
+		check(gd == expected, "testValidationLinks(), unexpected links, threads: "
+			+ std::to_string(threads));
+		// Links are sorted by dest
+		for(const auto& nd: nodes)
+			for(size_t i = 1; i < nd.links.size(); ++i)
+				check(std::less<decltype(nd.links[i].dest)>()(nd.links[i - 1].dest, nd.links[i].dest)
+					, "testValidationLinks(), links should be sorted by unique dest");
+	}
+}
+
+//! \brief Nodes with the duplicated links, one-sided arcs and a self link
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \return Graph<WEIGHTED>::NodesT  - nodes to be validated
+template<bool WEIGHTED>
+typename Graph<WEIGHTED>::NodesT invalidNodes()
+{
+	using GraphT = Graph<WEIGHTED>;
+	auto inpLinks = [](std::initializer_list<pair<Id, float>> links) {
+		typename GraphT::InpLinksT  res;
+		for(const auto& ln: links)
+			res.push_back(inpLink<typename GraphT::InpLinkT>(ln.first, ln.second));
+		return res;
+	};
+
+	GraphT  graph(5);
+	graph.addNodes(1, 6);
+	graph.template addNodeLinks<true>(1, inpLinks({{2, 1}, {3, 2}, {2, 5}}));
+	graph.template addNodeLinks<true>(2, inpLinks({{1, 1}, {5, 4}}));
+	graph.template addNodeLinks<true>(4, inpLinks({{1, 3}, {1, 4}, {5, 2}}));
+	graph.template addNodeLinks<true>(5, inpLinks({{4, 2}, {3, 1}, {3, 6}}));
+	auto  nodes = std::move(graph.finalize());
+	// Note: the Graph converts self links into the self weight, so the self
+	// link is added directly
+	auto&  nd = nodes.front();
+	InpOperations<!WEIGHTED>::addLink(&nd, &nd, 3);
+	return nodes;
+}
+
+//! \brief Check that the client validation with the skipped library one
+//! 	yields the same nodes as the library validation
+//!
+//! \tparam WEIGHTED bool  - whether the links are weighted
+//! \return void
+template<bool WEIGHTED>
+void checkValidationLibrary()
+{
+	const string  title = string("testValidationLibrary(), ")
+		+ (WEIGHTED ? "weighted" : "unweighted");
+	auto  nodes = invalidNodes<WEIGHTED>();
+	validateLinks(nodes);
+	const auto  hier = cluster(std::move(nodes), false, false);
+	const auto  libhier = cluster(invalidNodes<WEIGHTED>(), false, true);
+	GraphDump  gd;
+	gd.assign(hier->nodes(), true);
+	GraphDump  libgd;
+	libgd.assign(libhier->nodes(), true);
+	check(gd == libgd, title + ": the validated nodes differ from the library ones");
+
+	// The last duplicated link is retained, back links have zero weight
+	// (the default weight for the unweighted links), the self link forms
+	// the self weight
+	const float  wdef = WEIGHTED ? 0 : 1;
+	const tuple<Id, Id, float>  links[] = {make_tuple(1, 2, WEIGHTED ? 5 : 1)
+		, make_tuple(1, 4, wdef), make_tuple(4, 1, WEIGHTED ? 4 : 1)
+		, make_tuple(3, 5, wdef), make_tuple(5, 3, WEIGHTED ? 6 : 1)};
+	for(const auto& ln: links)
+		check(std::binary_search(gd.links.begin(), gd.links.end(), ln), title
+			+ ": the link is absent: " + std::to_string(std::get<0>(ln)) + " -> "
+			+ std::to_string(std::get<1>(ln)));
+	check(gd.links.size() == 12, title + ": unexpected number of links");
+	check(std::get<1>(gd.nodes.front()) == (WEIGHTED ? 3 : 1)
+		, title + ": unexpected self weight");
+}
+
+void testValidationLibrary()
+{
+	checkValidationLibrary<true>();
+	checkValidationLibrary<false>();
+}